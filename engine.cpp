@@ -0,0 +1,1256 @@
+#include "engine.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#ifdef TICTACTOE_SOLVED_TABLE
+constexpr SolvedTable solvedTable{};
+static_assert(solvedTable.value[0] == 0, "Tic Tac Toe has to be a draw with perfect play");
+#endif
+void TerminalKernel::scalar(const BitBoard* boards, uint8_t* status, size_t count){
+    for (size_t i = 0; i < count; i++){
+        status[i] = statusOf(boards[i]);
+    }
+};
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+void TerminalKernel::sse2(const BitBoard* boards, uint8_t* status, size_t count){
+    const __m128i full = _mm_set1_epi32(BitBoard::full);
+    const __m128i winBits = _mm_set1_epi32(0x00020001);
+    const __m128i one = _mm_set1_epi32(XWins);
+    const __m128i draw = _mm_set1_epi32(Draw);
+    const __m128i rowStarts = _mm_set1_epi16(0x49);
+    const __m128i columnStarts = _mm_set1_epi16(0x07);
+    const __m128i diagonalStart = _mm_set1_epi16(0x01);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4){
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(boards + i));
+        __m128i shift2 = _mm_srli_epi16(v, 2);
+        __m128i shift4 = _mm_srli_epi16(v, 4);
+        __m128i shift6 = _mm_srli_epi16(v, 6);
+        __m128i rows = _mm_and_si128(_mm_and_si128(v, _mm_srli_epi16(v, 1)), _mm_and_si128(shift2, rowStarts));
+        __m128i columns = _mm_and_si128(_mm_and_si128(v, _mm_srli_epi16(v, 3)), _mm_and_si128(shift6, columnStarts));
+        __m128i diagonals = _mm_and_si128(_mm_and_si128(shift4, diagonalStart), 
+            _mm_or_si128(_mm_and_si128(v, _mm_srli_epi16(v, 8)), _mm_and_si128(shift2, shift6)));
+        __m128i noWin = _mm_cmpeq_epi16(_mm_or_si128(_mm_or_si128(rows, columns), diagonals), zero);
+        // The x half of a lane becomes bit 0 and the o half bit 1.
+        __m128i bits = _mm_andnot_si128(noWin, winBits);
+        __m128i result = _mm_or_si128(_mm_and_si128(bits, one), _mm_srli_epi32(bits, 16));
+        __m128i occupied = _mm_and_si128(_mm_or_si128(v, _mm_srli_epi32(v, 16)), full);
+        __m128i isDraw = _mm_and_si128(_mm_cmpeq_epi32(occupied, full), _mm_cmpeq_epi32(result, zero));
+        result = _mm_or_si128(result, _mm_and_si128(isDraw, draw));
+        uint32_t bytes = uint32_t(_mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(result, zero), zero)));
+        std::memcpy(status + i, &bytes, 4);
+    }
+    scalar(boards + i, status + i, count - i);
+};
+__attribute__((target("avx2")))
+void TerminalKernel::avx2(const BitBoard* boards, uint8_t* status, size_t count){
+    const __m256i full = _mm256_set1_epi32(BitBoard::full);
+    const __m256i winBits = _mm256_set1_epi32(0x00020001);
+    const __m256i one = _mm256_set1_epi32(XWins);
+    const __m256i draw = _mm256_set1_epi32(Draw);
+    const __m256i rowStarts = _mm256_set1_epi16(0x49);
+    const __m256i columnStarts = _mm256_set1_epi16(0x07);
+    const __m256i diagonalStart = _mm256_set1_epi16(0x01);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8){
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(boards + i));
+        __m256i shift2 = _mm256_srli_epi16(v, 2);
+        __m256i shift4 = _mm256_srli_epi16(v, 4);
+        __m256i shift6 = _mm256_srli_epi16(v, 6);
+        __m256i rows = _mm256_and_si256(_mm256_and_si256(v, _mm256_srli_epi16(v, 1)), _mm256_and_si256(shift2, rowStarts));
+        __m256i columns = _mm256_and_si256(_mm256_and_si256(v, _mm256_srli_epi16(v, 3)), _mm256_and_si256(shift6, columnStarts));
+        __m256i diagonals = _mm256_and_si256(_mm256_and_si256(shift4, diagonalStart), 
+            _mm256_or_si256(_mm256_and_si256(v, _mm256_srli_epi16(v, 8)), _mm256_and_si256(shift2, shift6)));
+        __m256i noWin = _mm256_cmpeq_epi16(_mm256_or_si256(_mm256_or_si256(rows, columns), diagonals), zero);
+        __m256i bits = _mm256_andnot_si256(noWin, winBits);
+        __m256i result = _mm256_or_si256(_mm256_and_si256(bits, one), _mm256_srli_epi32(bits, 16));
+        __m256i occupied = _mm256_and_si256(_mm256_or_si256(v, _mm256_srli_epi32(v, 16)), full);
+        __m256i isDraw = _mm256_and_si256(_mm256_cmpeq_epi32(occupied, full), _mm256_cmpeq_epi32(result, zero));
+        result = _mm256_or_si256(result, _mm256_and_si256(isDraw, draw));
+        // The packs work inside each 128 bit half, so the first 4 bytes of each half are the status of 4 boards.
+        __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(result, zero), zero);
+        uint32_t low = uint32_t(_mm_cvtsi128_si32(_mm256_castsi256_si128(packed)));
+        uint32_t high = uint32_t(_mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1)));
+        std::memcpy(status + i, &low, 4);
+        std::memcpy(status + i + 4, &high, 4);
+    }
+    sse2(boards + i, status + i, count - i);
+};
+#endif
+std::vector<TerminalKernel> TerminalKernel::available(){
+    std::vector<TerminalKernel> kernels = {{"scalar", scalar}};
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")){
+        kernels.push_back({"sse2", sse2});
+    }
+    if (__builtin_cpu_supports("avx2")){
+        kernels.push_back({"avx2", avx2});
+    }
+#endif
+    return kernels;
+};
+const TerminalKernel& TerminalKernel::best(){
+    static const TerminalKernel kernel = available().back();
+    return kernel;
+};
+void TranspositionTable::clear(){
+    for (Entry& entry : entries){
+        entry.data.store(0, std::memory_order_relaxed);
+        entry.check.store(0, std::memory_order_relaxed);
+    }
+    hits = 0;
+    misses = 0;
+};
+TranspositionTable& TranspositionTable::shared(){
+    static TranspositionTable table;
+    return table;
+};
+uint32_t OpeningBook::checksum(const void* data, size_t size){
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++){
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+};
+bool OpeningBook::load(const char* path){
+    unload();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+    struct stat info;
+    size_t expected = sizeof(Header) + entryCount * sizeof(Entry);
+    if (fstat(fd, &info) != 0 || size_t(info.st_size) != expected){
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED){
+        return false;
+    }
+    const Header* header = static_cast<const Header*>(data);
+    const Entry* table = reinterpret_cast<const Entry*>(header + 1);
+    if (std::memcmp(header->magic, magic, 4) != 0 || header->version != version || header->entryCount != entryCount
+        || header->checksum != checksum(table, entryCount * sizeof(Entry))){
+        munmap(data, expected);
+        return false;
+    }
+    mapping = data;
+    mappingSize = expected;
+    entries = table;
+    return true;
+};
+void OpeningBook::unload(){
+    if (mapping){
+        munmap(mapping, mappingSize);
+    }
+    entries = nullptr;
+    mapping = nullptr;
+    mappingSize = 0;
+};
+bool OpeningBook::lookup(const BitBoard& currentBoard, char c, int& cell, int8_t* value) const {
+    if (!entries){
+        return false;
+    }
+    int xCount = __builtin_popcount(currentBoard.x);
+    int oCount = __builtin_popcount(currentBoard.o);
+    char toMove = (xCount == oCount) ? 'X' : 'O';
+    if (c != toMove || xCount - oCount > 1 || xCount < oCount){
+        return false;
+    }
+    const Entry& entry = entries[currentBoard.index()];
+    if (entry.bestMove < 0 || !currentBoard.isFree(entry.bestMove)){
+        return false;
+    }
+    cell = entry.bestMove;
+    if (value){
+        *value = entry.value;
+    }
+    return true;
+};
+bool OpeningBook::save(const char* path, const std::vector<Entry>& table){
+    if (table.size() != entryCount){
+        return false;
+    }
+    Header header;
+    std::memcpy(header.magic, magic, 4);
+    header.version = version;
+    header.entryCount = entryCount;
+    header.checksum = checksum(table.data(), table.size() * sizeof(Entry));
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Entry));
+    return bool(out);
+};
+OpeningBook& OpeningBook::shared(){
+    static OpeningBook book;
+    return book;
+};
+void SearchStats::print(std::ostream& out, const char* counted) const {
+    out << counted << " " << nodes;
+#ifdef TICTACTOE_STATS
+    out << ", leaves " << leaves << ", table hits " << tableHits << ", cutoffs " << cutoffs << ", max depth " << maxDepth << ", branching factor " 
+        << branchingFactor();
+#endif
+    out << ", time " << seconds * 1000.0 << " ms" << std::endl;
+};
+void PonderThread::stop(){
+    if (!thread.joinable()){
+        return;
+    }
+    token.cancel();
+    thread.join();
+};
+GameBoard::GameBoard(int psize, int pwinLength) : size(psize), winLength(pwinLength), board(psize * psize), winner(' '), filled(0) {
+    history.reserve(board.size());
+    undone.reserve(board.size());
+    static constexpr int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    std::vector<std::vector<int>> linesOfCell(board.size());
+    int lines = 0;
+    for (const auto& direction : directions){
+        for (int row = 0; row < size; row++){
+            for (int column = 0; column < size; column++){
+                int endRow = row + (winLength - 1) * direction[0];
+                int endColumn = column + (winLength - 1) * direction[1];
+                if (endRow >= size || endColumn < 0 || endColumn >= size){
+                    continue;
+                }
+                for (int k = 0; k < winLength; k++){
+                    linesOfCell[(row + k * direction[0]) * size + column + k * direction[1]].push_back(lines);
+                }
+                lines++;
+            }
+        }
+    }
+    lineStart.push_back(0);
+    for (const std::vector<int>& cellLinesOfCell : linesOfCell){
+        cellLines.insert(cellLines.end(), cellLinesOfCell.begin(), cellLinesOfCell.end());
+        lineStart.push_back(int(cellLines.size()));
+    }
+    lineCount[0].assign(lines, 0);
+    lineCount[1].assign(lines, 0);
+    completed[0] = 0;
+    completed[1] = 0;
+};
+char* GameBoard::renderRow(int row, char* out) const {
+    if (size >= 10 && row < 9){
+        *out++ = ' ';
+    }
+    out += std::snprintf(out, 12, "%d", row+1);
+    *out++ = ' ';
+    *out++ = '|';
+    for(int i = 0; i < size; i++){
+        const Field& field = board[row * size + i];
+        *out++ = ' ';
+        *out++ = field.isFree ? ' ' : (field.isValueX ? 'X' : 'O');
+        *out++ = ' ';
+        *out++ = '|';
+    }
+    *out++ = '\n';
+    return out;
+};
+char* GameBoard::renderSeperator(char* out) const {
+    *out++ = ' ';
+    *out++ = ' ';
+    if (size >= 10){
+        *out++ = ' ';
+    }
+    out = std::fill_n(out, 4*size+1, '-');
+    *out++ = '\n';
+    return out;
+};
+size_t GameBoard::render(char* out) const {
+    char* start = out;
+    out = std::fill_n(out, (size >= 10) ? 4 : 3, ' ');
+    for (int i = 0; i < size; i++){
+        int digits = std::snprintf(out + 1, 12, "%d", i+1);
+        *out = ' ';
+        out = std::fill_n(out + 1 + digits, 3 - digits, ' ');
+    }
+    while (out > start && out[-1] == ' '){
+        out--;
+    }
+    *out++ = '\n';
+    out = renderSeperator(out);
+    for (int k=0;k<size;k++){
+        out = renderRow(k, out);
+        out = renderSeperator(out);
+    }
+    return size_t(out - start);
+};
+void GameBoard::printBoard() const {
+    char frame[4096];
+    if (frameBytes() <= sizeof(frame)){
+        std::cout.write(frame, std::streamsize(render(frame)));
+        return;
+    }
+    std::vector<char> large(frameBytes());
+    std::cout.write(large.data(), std::streamsize(render(large.data())));
+};
+void GameBoard::countLines(int cell, char c, int delta){
+    int side = (c == 'X') ? 0 : 1;
+    for (int i = lineStart[cell]; i < lineStart[cell + 1]; i++){
+        uint8_t& count = lineCount[side][cellLines[i]];
+        if (count == winLength){
+            completed[side]--;
+        }
+        count = uint8_t(count + delta);
+        if (count == winLength){
+            completed[side]++;
+        }
+    }
+};
+void GameBoard::insert(int row, int column, char c){
+    if (place(row * size + column, c)){
+        undone.clear();
+    }
+};
+bool GameBoard::place(int cell, char c){
+    Field& field = board[cell];
+    if (!field.getFree() || (c != 'X' && c != 'O')){
+        return false;
+    }
+    HistoryEntry entry;
+    entry.cell = cell;
+    entry.c = c;
+    history.push_back(entry);
+    field.setValue(c == 'X');
+    field.setFree(false);
+    filled++;
+    countLines(cell, c, 1);
+    if (winner == ' ' && completed[(c == 'X') ? 0 : 1] > 0){
+        winner = c;
+    }
+    return true;
+};
+void GameBoard::updateWinner(){
+    if (winner != ' ' && completed[(winner == 'X') ? 0 : 1] > 0){
+        return;
+    }
+    winner = (completed[0] > 0) ? 'X' : (completed[1] > 0) ? 'O' : ' ';
+};
+bool GameBoard::undo(){
+    if (history.empty()){
+        return false;
+    }
+    HistoryEntry entry = history.back();
+    history.pop_back();
+    board[entry.cell].setFree(true);
+    board[entry.cell].setValue(false);
+    filled--;
+    countLines(entry.cell, entry.c, -1);
+    updateWinner();
+    undone.push_back(entry);
+    return true;
+};
+bool GameBoard::redo(){
+    if (undone.empty()){
+        return false;
+    }
+    HistoryEntry entry = undone.back();
+    undone.pop_back();
+    place(entry.cell, entry.c);
+    return true;
+};
+void GameBoard::refree(int row, int column){
+    if (at(row, column).getFree()){
+        return;
+    }
+    int cell = row * size + column;
+    if (!history.empty() && history.back().cell == cell){
+        undo();
+        undone.pop_back();
+        return;
+    }
+    auto entry = std::find_if(history.begin(), history.end(), [cell](const HistoryEntry& entry){ return entry.cell == cell; });
+    if (entry == history.end()){
+        return;
+    }
+    history.erase(entry);
+    undone.clear();
+    countLines(cell, at(row, column).getValue(), -1);
+    at(row, column).setFree(true);
+    at(row, column).setValue(false);
+    filled--;
+    updateWinner();
+};
+uint8_t* GameRecordArena::allocate(size_t bytes){
+    if (blocks.empty() || used + bytes > blockSize){
+        if (!blocks.empty()){
+            currentBlock++;
+        }
+        if (currentBlock == blocks.size()){
+            blocks.push_back(std::make_unique<uint8_t[]>(blockSize));
+        }
+        used = 0;
+    }
+    uint8_t* memory = blocks[currentBlock].get() + used;
+    used += bytes;
+    return memory;
+};
+GameRecord& GameRecordArena::nextRecord(){
+    if (count == recordBlocks.size() * recordsPerBlock){
+        recordBlocks.push_back(std::make_unique<GameRecord[]>(recordsPerBlock));
+    }
+    GameRecord& record = recordBlocks[count / recordsPerBlock][count % recordsPerBlock];
+    count++;
+    return record;
+};
+const GameRecord* GameRecordArena::add(const uint8_t* moves, size_t length, int size, char result){
+    if (length > blockSize || length > UINT16_MAX){
+        return nullptr;
+    }
+    uint8_t* copy = allocate(length);
+    std::memcpy(copy, moves, length);
+    GameRecord& record = nextRecord();
+    record.moves = copy;
+    record.length = uint16_t(length);
+    record.size = uint8_t(size);
+    record.result = result;
+    return &record;
+};
+const GameRecord* GameRecordArena::add(const GameBoard& game){
+    size_t length = game.history.size();
+    if (length > blockSize || length > UINT16_MAX || game.size * game.size > 256){
+        return nullptr;
+    }
+    uint8_t* moves = allocate(length);
+    for (size_t i = 0; i < length; i++){
+        moves[i] = uint8_t(game.history[i].cell);
+    }
+    GameRecord& record = nextRecord();
+    record.moves = moves;
+    record.length = uint16_t(length);
+    record.size = uint8_t(game.size);
+    record.result = game.winner == ' ' ? 'D' : game.winner;
+    return &record;
+};
+void GameLog::writeLength(size_t length, std::vector<uint8_t>& out){
+    for (; length >= 255; length -= 255){
+        out.push_back(255);
+    }
+    out.push_back(uint8_t(length));
+};
+void GameLog::compress(const uint8_t* in, size_t size, std::vector<uint8_t>& out){
+    out.clear();
+    uint32_t table[4096] = {0};
+    size_t anchor = 0;
+    size_t i = 0;
+    auto emit = [&](size_t literals, size_t offset, size_t match){
+        size_t matchCode = match ? match - 4 : 0;
+        out.push_back(uint8_t((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(matchCode, 15)));
+        if (literals >= 15){
+            writeLength(literals - 15, out);
+        }
+        out.insert(out.end(), in + anchor, in + anchor + literals);
+        if (match){
+            out.push_back(uint8_t(offset));
+            out.push_back(uint8_t(offset >> 8));
+            if (matchCode >= 15){
+                writeLength(matchCode - 15, out);
+            }
+        }
+    };
+    while (i + 4 <= size){
+        uint32_t sequence;
+        std::memcpy(&sequence, in + i, 4);
+        uint32_t hash = (sequence * 2654435761u) >> 20;
+        size_t candidate = table[hash];
+        table[hash] = uint32_t(i + 1);
+        uint32_t found;
+        if (candidate && i + 1 - candidate <= 65535 && (std::memcpy(&found, in + candidate - 1, 4), found == sequence)){
+            size_t start = candidate - 1;
+            size_t length = 4;
+            while (i + length < size && in[start + length] == in[i + length]){
+                length++;
+            }
+            emit(i - anchor, i - start, length);
+            i += length;
+            anchor = i;
+        } else {
+            i++;
+        }
+    }
+    emit(size - anchor, 0, 0);
+};
+bool GameLog::readLength(const uint8_t*& in, const uint8_t* end, size_t& length){
+    uint8_t byte = 255;
+    while (byte == 255){
+        if (in >= end){
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    }
+    return true;
+};
+bool GameLog::decompress(const uint8_t* in, size_t size, uint8_t* out, size_t rawSize){
+    const uint8_t* end = in + size;
+    size_t written = 0;
+    while (in < end){
+        uint8_t token = *in++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(in, end, literals)){
+            return false;
+        }
+        if (literals > size_t(end - in) || literals > rawSize - written){
+            return false;
+        }
+        std::memcpy(out + written, in, literals);
+        in += literals;
+        written += literals;
+        if (in == end){
+            break;
+        }
+        if (end - in < 2){
+            return false;
+        }
+        size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+        in += 2;
+        size_t match = (token & 15);
+        if (match == 15 && !readLength(in, end, match)){
+            return false;
+        }
+        match += 4;
+        if (offset == 0 || offset > written || match > rawSize - written){
+            return false;
+        }
+        for (size_t k = 0; k < match; k++, written++){
+            out[written] = out[written - offset];
+        }
+    }
+    return written == rawSize;
+};
+GameLogWriter::GameLogWriter(const char* path, bool pcompress) : out(path, std::ios::binary | std::ios::trunc), compress(pcompress), blockGames(0), games(0) {
+    GameLog::FileHeader header;
+    std::memcpy(header.magic, GameLog::magic, 4);
+    header.version = GameLog::version;
+    header.flags = compress ? GameLog::compressed : 0;
+    header.reserved = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    offset = sizeof(header);
+    block.reserve(GameLog::blockBytes + 16);
+};
+void GameLogWriter::add(const GameRecord& record){
+    if (record.size != 3 || record.length > 9){
+        return;
+    }
+    uint8_t result = (record.result == 'X') ? 1 : (record.result == 'O') ? 2 : 3;
+    uint8_t first = uint8_t(record.length | (result << 4));
+    if (block.size() + GameLog::gameBytes(first) > GameLog::blockBytes){
+        flushBlock();
+    }
+    block.push_back(first);
+    for (int i = 0; i < record.length; i += 2){
+        uint8_t second = (i + 1 < record.length) ? record.moves[i+1] : 0;
+        block.push_back(uint8_t(record.moves[i] | (second << 4)));
+    }
+    blockGames++;
+    games++;
+};
+void GameLogWriter::add(const GameBoard& game){
+    uint8_t moves[9];
+    GameRecord record;
+    record.length = uint16_t(std::min<size_t>(game.history.size(), 9));
+    for (int i = 0; i < record.length; i++){
+        moves[i] = uint8_t(game.history[i].cell);
+    }
+    record.moves = moves;
+    record.size = uint8_t(game.size);
+    record.result = game.winner == ' ' ? 'D' : game.winner;
+    add(record);
+};
+void GameLogWriter::add(const GameRecordArena& arena){
+    for (size_t i = 0; i < arena.size(); i++){
+        add(arena[i]);
+    }
+};
+void GameLogWriter::flushBlock(){
+    if (blockGames == 0 || !out.is_open()){
+        return;
+    }
+    GameLog::IndexEntry entry;
+    entry.offset = offset;
+    entry.firstGame = games - blockGames;
+    index.push_back(entry);
+    GameLog::BlockHeader header;
+    header.games = blockGames;
+    header.rawBytes = uint32_t(block.size());
+    header.flags = 0;
+    const std::vector<uint8_t>* data = &block;
+    if (compress){
+        GameLog::compress(block.data(), block.size(), packed);
+        if (packed.size() < block.size()){
+            header.flags = GameLog::compressed;
+            data = &packed;
+        }
+    }
+    header.storedBytes = uint32_t(data->size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(data->data()), std::streamsize(data->size()));
+    offset += sizeof(header) + data->size();
+    block.clear();
+    blockGames = 0;
+};
+bool GameLogWriter::close(){
+    if (!out.is_open()){
+        return true;
+    }
+    flushBlock();
+    GameLog::Trailer trailer;
+    trailer.indexOffset = offset;
+    trailer.games = games;
+    trailer.blocks = uint32_t(index.size());
+    std::memcpy(trailer.magic, GameLog::trailerMagic, 4);
+    out.write(reinterpret_cast<const char*>(index.data()), std::streamsize(index.size() * sizeof(GameLog::IndexEntry)));
+    out.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+    bool written = bool(out);
+    out.close();
+    return written;
+};
+bool GameLogReader::open(const char* path){
+    if (data){
+        munmap(const_cast<uint8_t*>(data), size);
+        data = nullptr;
+        size = 0;
+        opened = false;
+    }
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0){
+        return false;
+    }
+    struct stat info;
+    bool valid = fstat(fd, &info) == 0 && size_t(info.st_size) >= sizeof(GameLog::FileHeader) + sizeof(GameLog::Trailer);
+    void* memory = valid ? mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (memory == MAP_FAILED){
+        return false;
+    }
+    data = static_cast<const uint8_t*>(memory);
+    size = size_t(info.st_size);
+    GameLog::FileHeader header = read<GameLog::FileHeader>(0);
+    GameLog::Trailer end = read<GameLog::Trailer>(size - sizeof(GameLog::Trailer));
+    if (std::memcmp(header.magic, GameLog::magic, 4) != 0 || header.version != GameLog::version 
+        || std::memcmp(end.magic, GameLog::trailerMagic, 4) != 0 || end.indexOffset > size - sizeof(GameLog::Trailer)
+        || (size - sizeof(GameLog::Trailer) - end.indexOffset) / sizeof(GameLog::IndexEntry) != end.blocks){
+        return false;
+    }
+    trailer = end;
+    opened = true;
+    return true;
+};
+bool GameLogReader::readBlock(uint32_t block, std::vector<uint8_t>& buffer, const uint8_t*& games, GameLog::BlockHeader& header) const {
+    uint64_t offset = entry(block).offset;
+    if (offset + sizeof(GameLog::BlockHeader) > trailer.indexOffset){
+        return false;
+    }
+    header = read<GameLog::BlockHeader>(offset);
+    const uint8_t* stored = data + offset + sizeof(GameLog::BlockHeader);
+    if (offset + sizeof(GameLog::BlockHeader) + header.storedBytes > trailer.indexOffset || header.rawBytes > GameLog::blockBytes
+        || (header.rawBytes == 0 && header.games != 0)){
+        return false;
+    }
+    if (!(header.flags & GameLog::compressed)){
+        games = stored;
+        return header.storedBytes == header.rawBytes;
+    }
+    buffer.resize(header.rawBytes);
+    games = buffer.data();
+    return GameLog::decompress(stored, header.storedBytes, buffer.data(), header.rawBytes);
+};
+bool GameLogReader::unpack(const uint8_t* game, uint8_t* moves, int& length, char& result){
+    length = *game & 15;
+    int code = *game >> 4;
+    if (length > 9 || code < 1 || code > 3){
+        return false;
+    }
+    uint16_t played = 0;
+    for (int k = 0; k < length; k++){
+        moves[k] = (game[1 + k / 2] >> ((k & 1) * 4)) & 15;
+        if (moves[k] >= 9 || (played >> moves[k]) & 1){
+            return false;
+        }
+        played |= uint16_t(1u << moves[k]);
+    }
+    result = code == 1 ? 'X' : code == 2 ? 'O' : 'D';
+    return true;
+};
+bool GameLogReader::game(uint64_t number, std::vector<int>& moves, char& result) const {
+    if (number >= games() || trailer.blocks == 0){
+        return false;
+    }
+    uint32_t low = 0;
+    uint32_t high = trailer.blocks;
+    while (high - low > 1){
+        uint32_t middle = (low + high) / 2;
+        if (entry(middle).firstGame <= number){
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    std::vector<uint8_t> buffer;
+    const uint8_t* game;
+    GameLog::BlockHeader header;
+    if (!readBlock(low, buffer, game, header)){
+        return false;
+    }
+    const uint8_t* end = game + header.rawBytes;
+    for (uint64_t skip = number - entry(low).firstGame; skip > 0 && game < end; skip--){
+        game += GameLog::gameBytes(*game);
+    }
+    uint8_t unpacked[9];
+    int length;
+    if (game >= end || game + GameLog::gameBytes(*game) > end || !unpack(game, unpacked, length, result)){
+        return false;
+    }
+    moves.assign(unpacked, unpacked + length);
+    return true;
+};
+bool GameLogReader::statistics(Statistics& statistics) const {
+    statistics = Statistics();
+    return forEachGame([&](const uint8_t* moves, int length, char result){
+        statistics.games++;
+        statistics.results[result == 'X' ? 0 : result == 'O' ? 1 : 2]++;
+        statistics.lengths[length]++;
+        if (length >= 1){
+            statistics.firstMoves[moves[0]]++;
+        }
+        if (length >= 2){
+            statistics.openings[moves[0] * 9 + moves[1]]++;
+        }
+    });
+};
+int ComputerPlayer::minimax(BitBoard& currentBoard, int depth, bool isMax, char c, char other){
+    nodes++;
+    SEARCH_STAT(stats.maxDepth = std::max(stats.maxDepth, depth);)
+    if (currentBoard.isWinner(other)){
+        SEARCH_STAT(stats.leaves++;)
+        return -10;
+    }
+    if (currentBoard.isWinner(c)){
+        SEARCH_STAT(stats.leaves++;)
+        return 10;
+    }
+    if (currentBoard.isDraw()){
+        SEARCH_STAT(stats.leaves++;)
+        return 0;
+    }
+    int transform;
+    uint32_t key = currentBoard.canonicalKey(isMax ? c : other, transform);
+    int stored;
+    if (table && table->probe(key, -1000, 1000, stored)){
+        SEARCH_STAT(stats.tableHits++;)
+        return isMax ? stored : -stored;
+    }
+    int best = isMax ? -1000 : 1000;
+    int bestCell = -1;
+    SEARCH_STAT(stats.expanded++;)
+    for (uint16_t free = currentBoard.freeCells(); free; free &= free - 1){
+        int cell = __builtin_ctz(free);
+        SEARCH_STAT(stats.children++;)
+        currentBoard.insert(cell, isMax ? c : other);
+        int score = minimax(currentBoard, depth+1, !isMax, c, other);
+        currentBoard.refree(cell);
+        if (isMax ? score > best : score < best){
+            best = score;
+            bestCell = cell;
+        }
+    }
+    if (table){
+        table->store(key, isMax ? best : -best, TranspositionTable::Exact, symmetryTable.cell[transform][bestCell]);
+    }
+    return best;
+};
+int ComputerPlayer::minimax(GameBoard& currentBoard, int depth, bool isMax, char c, char other){
+    BitBoard bits = currentBoard.toBitBoard();
+    return minimax(bits, depth, isMax, c, other);
+};
+int ComputerPlayer::orderMoves(uint16_t candidates, int depth, int side, int first, int* moves){
+    static constexpr int centreCornersEdges[9] = {2, 1, 2, 1, 3, 1, 2, 1, 2};
+    uint32_t scores[9];
+    int count = 0;
+    for (uint16_t free = candidates; free; free &= free - 1){
+        int cell = __builtin_ctz(free);
+        uint32_t score = 0;
+        if (ordering != RowMajor){
+            score = centreCornersEdges[cell];
+        }
+        if (ordering == KillerHistory){
+            score += history[side][cell] << 2;
+            if (cell == killers[depth]){
+                score = 1u << 30;
+            }
+        }
+        if (cell == first){
+            score = 1u << 31;
+        }
+        int i = count++;
+        while (i > 0 && scores[i-1] < score){
+            scores[i] = scores[i-1];
+            moves[i] = moves[i-1];
+            i--;
+        }
+        scores[i] = score;
+        moves[i] = cell;
+    }
+    return count;
+};
+int ComputerPlayer::alphaBeta(BitBoard& currentBoard, int depth, int alpha, int beta, bool isMax, char c, char other){
+    nodes++;
+    if (token && (stopped || ((nodes & 1023) == 0 && token->isCancelled()))){
+        stopped = true;
+        return 0;
+    }
+    SEARCH_STAT(stats.maxDepth = std::max(stats.maxDepth, depth);)
+    if (currentBoard.isWinner(other)){
+        SEARCH_STAT(stats.leaves++;)
+        return -10;
+    }
+    if (currentBoard.isWinner(c)){
+        SEARCH_STAT(stats.leaves++;)
+        return 10;
+    }
+    if (currentBoard.isDraw()){
+        SEARCH_STAT(stats.leaves++;)
+        return 0;
+    }
+    char toMove = isMax ? c : other;
+    int transform;
+    uint32_t key = currentBoard.canonicalKey(toMove, transform);
+    int first = -1;
+    if (table){
+        int stored;
+        if (isMax ? table->probe(key, alpha, beta, stored) : table->probe(key, -beta, -alpha, stored)){
+            SEARCH_STAT(stats.tableHits++;)
+            return isMax ? stored : -stored;
+        }
+        first = table->bestMove(key);
+        if (first >= 0){
+            first = symmetryTable.inverse[transform][first];
+        }
+    }
+    int side = (toMove == 'X') ? 0 : 1;
+    int moves[9];
+    int count = orderMoves(currentBoard.freeCells(), depth, side, first, moves);
+    int best = isMax ? -1000 : 1000;
+    int bestCell = -1;
+    int a = alpha;
+    int b = beta;
+    SEARCH_STAT(stats.expanded++;)
+    for (int i = 0; i < count; i++){
+        int cell = moves[i];
+        SEARCH_STAT(stats.children++;)
+        currentBoard.insert(cell, toMove);
+        int score = alphaBeta(currentBoard, depth+1, a, b, !isMax, c, other);
+        currentBoard.refree(cell);
+        if (stopped){
+            return 0;
+        }
+        if (isMax ? score > best : score < best){
+            best = score;
+            bestCell = cell;
+        }
+        if (isMax){
+            a = std::max(a, best);
+        } else {
+            b = std::min(b, best);
+        }
+        if (a >= b){
+            SEARCH_STAT(stats.cutoffs++;)
+            killers[depth] = cell;
+            history[side][cell] += uint32_t((9 - depth) * (9 - depth));
+            break;
+        }
+    }
+    if (table){
+        TranspositionTable::Bound bound = TranspositionTable::Exact;
+        if (best <= alpha){
+            bound = isMax ? TranspositionTable::Upper : TranspositionTable::Lower;
+        } else if (best >= beta){
+            bound = isMax ? TranspositionTable::Lower : TranspositionTable::Upper;
+        }
+        table->store(key, isMax ? best : -best, bound, symmetryTable.cell[transform][bestCell]);
+    }
+    return best;
+};
+ComputerPlayer::Move ComputerPlayer::findBestMove(BitBoard& currentBoard, char c, char other){
+    nodes = 0;
+    stats = SearchStats();
+    SearchTimer timer(stats);
+    int cell;
+#ifdef TICTACTOE_SOLVED_TABLE
+    uint32_t index = currentBoard.index();
+    bool xToMove = __builtin_popcount(currentBoard.x) == __builtin_popcount(currentBoard.o);
+    if (mode == AlphaBeta && useSolvedTable && (c == 'X') == xToMove && solvedTable.bestMove[index] >= 0){
+        Move solvedMove;
+        solvedMove.row = solvedTable.bestMove[index] / 3;
+        solvedMove.column = solvedTable.bestMove[index] % 3;
+        return solvedMove;
+    }
+#endif
+    if (mode == AlphaBeta && book && book->lookup(currentBoard, c, cell)){
+        Move bookMove;
+        bookMove.row = cell / 3;
+        bookMove.column = cell % 3;
+        return bookMove;
+    }
+    if (mode == AlphaBeta){
+        return findBestMoveAlphaBeta(currentBoard, c, other);
+    }
+    int bestVal = -1000;
+    Move bestMove;
+    bestMove.row = -1;
+    bestMove.column = -1;
+    SEARCH_STAT(stats.expanded++;)
+    for (uint16_t free = currentBoard.distinctMoves(c); free; free &= free - 1){
+        int cell = __builtin_ctz(free);
+        SEARCH_STAT(stats.children++;)
+        currentBoard.insert(cell, c);
+        int moveVal = minimax(currentBoard, 0, false, c, other);
+        currentBoard.refree(cell);
+        if (moveVal > bestVal){
+            bestMove.row = cell / 3;
+            bestMove.column = cell % 3;
+            bestVal = moveVal;
+        }
+    }
+    return bestMove;
+};
+ComputerPlayer::Move ComputerPlayer::findBestMoveAlphaBeta(BitBoard& currentBoard, char c, char other, int* value){
+    stopped = false;
+    std::fill(killers, killers + 10, -1);
+    for (int side = 0; side < 2; side++){
+        for (int cell = 0; cell < 9; cell++){
+            history[side][cell] >>= 1;
+        }
+    }
+    int transform;
+    uint32_t key = currentBoard.canonicalKey(c, transform);
+    int first = table ? table->bestMove(key) : -1;
+    if (first >= 0){
+        first = symmetryTable.inverse[transform][first];
+    }
+    int moves[9];
+    int count = orderMoves(currentBoard.distinctMoves(c), 0, (c == 'X') ? 0 : 1, first, moves);
+    int bestVal = -1000;
+    int bestCell = -1;
+    SEARCH_STAT(stats.expanded++;)
+    for (int i = 0; i < count; i++){
+        int cell = moves[i];
+        int alpha = (cell < bestCell) ? bestVal - 1 : bestVal;
+        SEARCH_STAT(stats.children++;)
+        currentBoard.insert(cell, c);
+        int moveVal = alphaBeta(currentBoard, 1, alpha, 1000, false, c, other);
+        currentBoard.refree(cell);
+        if (stopped){
+            break;
+        }
+        if (moveVal > bestVal || (moveVal == bestVal && cell < bestCell)){
+            bestVal = moveVal;
+            bestCell = cell;
+        }
+    }
+    if (bestCell < 0 && count > 0){
+        // The token stopped the search in the first move, so the move is only a guess: the first move of the order.
+        bestCell = moves[0];
+    }
+    if (value && !stopped){
+        *value = bestVal;
+    }
+    Move bestMove;
+    bestMove.row = (bestCell < 0) ? -1 : bestCell / 3;
+    bestMove.column = (bestCell < 0) ? -1 : bestCell % 3;
+    return bestMove;
+};
+ComputerPlayer::Move ComputerPlayer::findBestMove(GameBoard& currentBoard, char c, char other){
+    BitBoard bits = currentBoard.toBitBoard();
+    return findBestMove(bits, c, other);
+};
+bool generateOpeningBook(const char* path){
+    OpeningBook::Entry none;
+    none.value = 0;
+    none.bestMove = -1;
+    std::vector<OpeningBook::Entry> table(OpeningBook::entryCount, none);
+    std::vector<bool> visited(OpeningBook::entryCount, false);
+    TranspositionTable searchTable;
+    ComputerPlayer solver(&searchTable);
+    solver.book = nullptr;
+    solver.useSolvedTable = false;
+    std::vector<BitBoard> stack(1, BitBoard());
+    while (!stack.empty()){
+        BitBoard position = stack.back();
+        stack.pop_back();
+        uint32_t index = position.index();
+        if (visited[index]){
+            continue;
+        }
+        visited[index] = true;
+        if (position.isWinner('X') || position.isWinner('O') || position.isDraw()){
+            continue;
+        }
+        char c = (__builtin_popcount(position.x) == __builtin_popcount(position.o)) ? 'X' : 'O';
+        char other = (c == 'X') ? 'O' : 'X';
+        ComputerPlayer::Move move = solver.findBestMove(position, c, other);
+        table[index].bestMove = int8_t(move.row * 3 + move.column);
+        table[index].value = int8_t(solver.alphaBeta(position, 0, -1000, 1000, true, c, other));
+        for (uint16_t free = position.freeCells(); free; free &= free - 1){
+            BitBoard next = position;
+            next.insert(__builtin_ctz(free), c);
+            stack.push_back(next);
+        }
+    }
+    return OpeningBook::save(path, table);
+};
+bool AgentSpec::parse(const std::string& name){
+    static constexpr uint32_t centreCornersEdges[9] = {2, 1, 2, 1, 3, 1, 2, 1, 2};
+    kind = Minimax;
+    epsilon = 0.0;
+    weights = nullptr;
+    iterations = 0;
+    if (name == "mcts" || name.compare(0, 5, "mcts:") == 0){
+        kind = MCTS;
+        iterations = 1000;
+        if (name.size() > 4){
+            char* end = nullptr;
+            iterations = std::strtoull(name.c_str() + 5, &end, 10);
+            return end != name.c_str() + 5 && *end == '\0' && iterations > 0;
+        }
+        return true;
+    }
+    if (name == "minimax"){
+        return true;
+    }
+    if (name == "random" || name == "weighted"){
+        kind = Random;
+        weights = (name == "weighted") ? centreCornersEdges : nullptr;
+        return true;
+    }
+    if (name.compare(0, 8, "epsilon:") == 0){
+        char* end = nullptr;
+        epsilon = std::strtod(name.c_str() + 8, &end);
+        kind = (epsilon <= 0) ? Minimax : (epsilon >= 1) ? Random : Epsilon;
+        return end != name.c_str() + 8 && *end == '\0' && epsilon >= 0 && epsilon <= 1;
+    }
+    return false;
+};
+uint64_t LatencyHistogram::upperBound(int index){
+    if (index < subBuckets){
+        return uint64_t(index);
+    }
+    int exponent = index / subBuckets;
+    return ((uint64_t(subBuckets + index % subBuckets + 1)) << (exponent - 3)) - 1;
+};
+void LatencyHistogram::merge(const LatencyHistogram& other){
+    for (int i = 0; i < 64 * subBuckets; i++){
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    maximum = std::max(maximum, other.maximum);
+};
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    uint64_t rank = uint64_t(fraction * double(total));
+    uint64_t seen = 0;
+    for (int i = 0; i < 64 * subBuckets; i++){
+        seen += counts[i];
+        if (seen > rank){
+            return std::min(upperBound(i), maximum);
+        }
+    }
+    return maximum;
+};
+void SelfPlayResult::merge(const SelfPlayResult& other){
+    games += other.games;
+    firstWins += other.firstWins;
+    draws += other.draws;
+    secondWins += other.secondWins;
+    seconds += other.seconds;
+    latency[0].merge(other.latency[0]);
+    latency[1].merge(other.latency[1]);
+    stats[0].merge(other.stats[0]);
+    stats[1].merge(other.stats[1]);
+};
+uint64_t gameSeed(uint64_t seed, uint64_t game){
+    uint64_t z = seed + (game + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+};
+SelfPlayResult runSelfPlay(const std::string& first, const std::string& second, uint64_t games, int threads, uint64_t seed, 
+    std::vector<GameRecordArena>* records, uint64_t firstGame){
+    AgentSpec specs[2];
+    if (!specs[0].parse(first) || !specs[1].parse(second)){
+        return SelfPlayResult();
+    }
+    return specs[0].visit([&](auto makeFirst){
+        return specs[1].visit([&](auto makeSecond){
+            return runSelfPlayAgents(makeFirst, makeSecond, games, threads, seed, records, firstGame);
+        });
+    });
+};
+OpeningBook::Entry PositionEvaluator::evaluate(uint16_t position, [[maybe_unused]] ComputerPlayer& engine){
+    OpeningBook::Entry result;
+    result.value = invalid;
+    result.bestMove = -1;
+    if (position >= 19683){
+        return result;
+    }
+    BitBoard board;
+    uint32_t rest = position;
+    for (int cell = 0; cell < 9; cell++, rest /= 3){
+        if (rest % 3 != 0){
+            board.insert(cell, rest % 3 == 1 ? 'X' : 'O');
+        }
+    }
+    int difference = __builtin_popcount(board.x) - __builtin_popcount(board.o);
+    bool xWins = board.isWinner('X');
+    bool oWins = board.isWinner('O');
+    char c = (difference == 0) ? 'X' : 'O';
+    char other = (c == 'X') ? 'O' : 'X';
+    if (difference < 0 || difference > 1 || (xWins && oWins) || board.isWinner(c)){
+        return result;
+    }
+    if (board.isWinner(other)){
+        // Only legal if the line came with the last move, so there has to be a field without which there is no line.
+        uint16_t last = (other == 'X') ? board.x : board.o;
+        bool needed = false;
+        for (uint16_t rest = last; rest && !needed; rest &= uint16_t(rest - 1)){
+            BitBoard before = board;
+            (other == 'X' ? before.x : before.o) = uint16_t(last & ~(rest & -rest));
+            needed = !before.isWinner(other);
+        }
+        if (!needed){
+            return result;
+        }
+    }
+#ifdef TICTACTOE_SOLVED_TABLE
+    result.value = solvedTable.value[position];
+    result.bestMove = solvedTable.bestMove[position];
+#else
+    if (board.isWinner(other)){
+        result.value = -10;
+    } else if (board.isDraw()){
+        result.value = 0;
+    } else if (int cell; OpeningBook::shared().lookup(board, c, cell, &result.value)){
+        result.bestMove = int8_t(cell);
+    } else {
+        int value = 0;
+        ComputerPlayer::Move move = engine.findBestMoveAlphaBeta(board, c, other, &value);
+        result.bestMove = int8_t(move.row * 3 + move.column);
+        result.value = int8_t(value);
+    }
+#endif
+    return result;
+};
+void PositionEvaluator::evaluateBatch(const uint16_t* positions, OpeningBook::Entry* results, size_t count, int threads){
+    if (threads <= 0){
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+    threads = int(std::min<size_t>(size_t(threads), (count + blockSize - 1) / blockSize));
+    std::atomic<size_t> nextBlock(0);
+    auto worker = [&](){
+        ComputerPlayer engine;
+        for (size_t start = nextBlock.fetch_add(blockSize); start < count; start = nextBlock.fetch_add(blockSize)){
+            size_t end = std::min(start + blockSize, count);
+            for (size_t i = start; i < end; i++){
+                results[i] = evaluate(positions[i], engine);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++){
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+};
+void PositionEvaluator::terminalStatus(const BitBoard* boards, uint8_t* status, size_t count, int threads){
+    TerminalKernel::Function kernel = TerminalKernel::best().run;
+    if (threads <= 0){
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+    threads = int(std::min<size_t>(size_t(threads), (count + blockSize - 1) / blockSize));
+    if (threads <= 1){
+        kernel(boards, status, count);
+        return;
+    }
+    std::atomic<size_t> nextBlock(0);
+    auto worker = [&](){
+        for (size_t start = nextBlock.fetch_add(blockSize); start < count; start = nextBlock.fetch_add(blockSize)){
+            kernel(boards + start, status + start, std::min(blockSize, count - start));
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++){
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+};
+uint64_t PositionEvaluator::evaluateFile(const char* inPath, const char* outPath, int threads){
+    std::ifstream in(inPath, std::ios::binary);
+    FileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, positionMagic, 4) != 0 || header.version != version){
+        return 0;
+    }
+    std::string tempPath = std::string(outPath) + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    FileHeader outHeader = header;
+    std::memcpy(outHeader.magic, resultMagic, 4);
+    out.write(reinterpret_cast<const char*>(&outHeader), sizeof(outHeader));
+    std::vector<uint16_t> positions(chunkSize);
+    std::vector<OpeningBook::Entry> results(chunkSize);
+    uint64_t done = 0;
+    while (done < header.count && in && out){
+        size_t count = size_t(std::min<uint64_t>(chunkSize, header.count - done));
+        in.read(reinterpret_cast<char*>(positions.data()), std::streamsize(count * sizeof(uint16_t)));
+        count = size_t(in.gcount()) / sizeof(uint16_t);
+        evaluateBatch(positions.data(), results.data(), count, threads);
+        out.write(reinterpret_cast<const char*>(results.data()), std::streamsize(count * sizeof(OpeningBook::Entry)));
+        done += count;
+        if (count == 0){
+            break;
+        }
+    }
+    out.close();
+    if (done != header.count || !out || std::rename(tempPath.c_str(), outPath) != 0){
+        std::remove(tempPath.c_str());
+        return 0;
+    }
+    return done;
+};
+bool PositionEvaluator::writePositions(const char* path, uint64_t count, uint64_t seed){
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    FileHeader header;
+    std::memcpy(header.magic, positionMagic, 4);
+    header.version = version;
+    header.count = count;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    FastRandom rng(seed);
+    std::vector<uint16_t> positions;
+    positions.reserve(chunkSize);
+    for (uint64_t i = 0; i < count && out; i++){
+        BitBoard board;
+        char c = 'X';
+        for (int moves = int(rng.below(9)); moves > 0 && !board.isWinner('X') && !board.isWinner('O'); moves--){
+            board.insert(rng.pick(board.freeCells()), c);
+            c = (c == 'X') ? 'O' : 'X';
+        }
+        positions.push_back(uint16_t(board.index()));
+        if (positions.size() == chunkSize || i + 1 == count){
+            out.write(reinterpret_cast<const char*>(positions.data()), std::streamsize(positions.size() * sizeof(uint16_t)));
+            positions.clear();
+        }
+    }
+    return bool(out);
+};
@@ -0,0 +1,4270 @@
+#ifndef TICTACTOE_ENGINE_H
+#define TICTACTOE_ENGINE_H
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+/**
+ * @brief Lookup table from a 9 bit mask to the base 3 number with a 1 at every set bit. Used to build the position index of a BitBoard without a loop.
+ */
+struct Base3Table {
+    uint16_t value[512];
+    constexpr Base3Table() : value() {
+        for (int mask = 0; mask < 512; mask++){
+            int power = 1;
+            for (int i = 0; i < 9; i++){
+                if (mask & (1 << i)){
+                    value[mask] += power;
+                }
+                power *= 3;
+            }
+        }
+    };
+};
+/**
+ * @brief Lookup table from a 9 bit mask to whether the fields of the mask contain a full row, column or diagonal. Used by BitBoard::isWinner, so the 
+ * search checks for a winner with one read instead of testing all 8 lines.
+ */
+struct WinTable {
+    /**
+     * @brief The 8 lines that win the game: 3 rows, 3 columns and the 2 diagonals.
+     */
+    static constexpr uint16_t lines[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+    bool value[512];
+    constexpr WinTable() : value() {
+        for (int mask = 0; mask < 512; mask++){
+            for (uint16_t line : lines){
+                if ((mask & line) == line){
+                    value[mask] = true;
+                }
+            }
+        }
+    };
+};
+static constexpr WinTable winTable{};
+/**
+ * @brief Lookup tables for the 8 symmetries of the board (4 rotations, each with and without a reflection).
+ * Transform t moves the field at cell to cell[t][cell], inverse[t] moves it back. mask[t] transforms a whole 9 bit mask at once.
+ */
+struct SymmetryTable {
+    uint8_t cell[8][9];
+    uint8_t inverse[8][9];
+    uint16_t mask[8][512];
+    constexpr SymmetryTable() : cell(), inverse(), mask() {
+        for (int t = 0; t < 8; t++){
+            for (int from = 0; from < 9; from++){
+                int row = from / 3;
+                int column = from % 3;
+                for (int r = 0; r < t % 4; r++){
+                    int rotated = column;
+                    column = 2 - row;
+                    row = rotated;
+                }
+                if (t >= 4){
+                    column = 2 - column;
+                }
+                cell[t][from] = uint8_t(row * 3 + column);
+                inverse[t][row * 3 + column] = uint8_t(from);
+            }
+            for (int m = 0; m < 512; m++){
+                for (int from = 0; from < 9; from++){
+                    if (m & (1 << from)){
+                        mask[t][m] |= uint16_t(1u << cell[t][from]);
+                    }
+                }
+            }
+        }
+    };
+};
+/**
+ * @brief The symmetry tables, computed by the compiler.
+ */
+static constexpr SymmetryTable symmetryTable{};
+/**
+ * @brief Class to represent the game board in the compact form used by the minimax search.
+ * @class BitBoard
+ *  Each player is stored as a 9 bit mask. Bit (row*3 + column) is set if the player occupies that field. Checking for a winner is a lookup of the 
+ * mask in winTable and checking for a draw is a popcount, which is a lot cheaper than going through the Fields of the GameBoard on every node.
+ */
+class BitBoard {
+public:
+    uint16_t x;
+    uint16_t o;
+    /**
+     * @brief Mask with all 9 fields set.
+     */
+    static constexpr uint16_t full = 0x1FF;
+    /**
+     * @brief The number of fields.
+     */
+    static constexpr int cells = 9;
+    /**
+     * @brief Constructor for the BitBoard class. Initializes an empty board.
+     */
+    BitBoard() : x(0), o(0) {};
+    /**
+     * @brief Function to compare two positions.
+     * @param other const BitBoard&. The other board.
+     * @return bool. True if both players occupy the same fields on both boards.
+     */
+    bool operator==(const BitBoard& other) const {
+        return x == other.x && o == other.o;
+    };
+    /**
+     * @brief Function to get the player whose turn it is. X always starts.
+     * @return char. 'X' if both have the same number of fields, 'O' otherwise.
+     */
+    char toMove() const {
+        return (__builtin_popcount(x) == __builtin_popcount(o)) ? 'X' : 'O';
+    };
+    /**
+     * @brief Function to insert a value into a field. Same behaviour as GameBoard::insert, occupied fields are left untouched.
+     * @param cell int. The field to be inserted into (row*3 + column).
+     * @param c char. The value to be inserted into the field. 'X' for X, 'O' for O.
+     * @return void
+     */
+    void insert(int cell, char c){
+        if (!isFree(cell)){
+            return;
+        }
+        if (c == 'X'){
+            x |= uint16_t(1u << cell);
+        } else if (c == 'O'){
+            o |= uint16_t(1u << cell);
+        }
+    };
+    /**
+     * @brief Function to remove a value from a field. Unlike GameBoard::refree both masks are cleared, so no stale value is left behind.
+     * @param cell int. The field to be removed from (row*3 + column).
+     * @return void
+     */
+    void refree(int cell){
+        x &= uint16_t(~(1u << cell));
+        o &= uint16_t(~(1u << cell));
+    };
+    /**
+     * @brief Function to check if a field is free.
+     * @param cell int. The field to be checked (row*3 + column).
+     * @return bool. True if the field is free, false if the field is occupied.
+     */
+    bool isFree(int cell) const {
+        return ((x | o) & (1u << cell)) == 0;
+    };
+    /**
+     * @brief Function to get all free fields at once.
+     * @return uint16_t. Mask with a bit set for every free field. Iterating the set bits from lowest to highest visits the fields in the same order as the row/column loops.
+     */
+    uint16_t freeCells() const {
+        return uint16_t(~(x | o) & full);
+    };
+    /**
+     * @brief Function to check if a player has won the game.
+     * @param c char. The player to be checked. 'X' for X, 'O' for O.
+     * @return bool. True if all fields of one of the win lines are occupied by the player, read from winTable.
+     */
+    bool isWinner(char c) const {
+        return winTable.value[(c == 'X') ? x : o];
+    };
+    /**
+     * @brief Function to check if the game is a draw.
+     * @return bool. True if all 9 fields are occupied.
+     */
+    bool isDraw() const {
+        return __builtin_popcount(x | o) == 9;
+    };
+    /**
+     * @brief Function to get the base 3 index of the position. Every field is a digit which is 0 if free, 1 for X and 2 for O.
+     * @return uint32_t. Number between 0 and 3^9 - 1 which is unique for every position.
+     */
+    uint32_t index() const {
+        static constexpr Base3Table base3{};
+        return base3.value[x] + 2u * base3.value[o];
+    };
+    /**
+     * @brief Function to get the key of the position for the transposition table.
+     * @param toMove char. The player whose turn it is. 'X' for X, 'O' for O.
+     * @return uint32_t. The base 3 index together with the player to move.
+     */
+    uint32_t key(char toMove) const {
+        return index() * 2u + (toMove == 'O' ? 1u : 0u);
+    };
+    /**
+     * @brief Function to rotate and/or reflect the board.
+     * @param t int. The symmetry, see SymmetryTable.
+     * @return BitBoard. The transformed board.
+     */
+    BitBoard transformed(int t) const {
+        BitBoard result;
+        result.x = symmetryTable.mask[t][x];
+        result.o = symmetryTable.mask[t][o];
+        return result;
+    };
+    /**
+     * @brief Function to get the index of the canonical position. All 8 rotations and reflections of a position have the same canonical position, 
+     * which is the one with the lowest base 3 index.
+     * @param transform int&. Set to the symmetry that turns this board into the canonical position.
+     * @return uint32_t. The base 3 index of the canonical position.
+     */
+    uint32_t canonicalIndex(int& transform) const {
+        uint32_t best = index();
+        transform = 0;
+        for (int t = 1; t < 8; t++){
+            uint32_t candidate = transformed(t).index();
+            if (candidate < best){
+                best = candidate;
+                transform = t;
+            }
+        }
+        return best;
+    };
+    /**
+     * @brief Function to get the key of the canonical position for the transposition table. Symmetric positions share one entry.
+     * @param toMove char. The player whose turn it is. 'X' for X, 'O' for O.
+     * @param transform int&. Set to the symmetry that turns this board into the canonical position. Moves stored in the table are in that orientation.
+     * @return uint32_t. The canonical base 3 index together with the player to move.
+     */
+    uint32_t canonicalKey(char toMove, int& transform) const {
+        return canonicalIndex(transform) * 2u + (toMove == 'O' ? 1u : 0u);
+    };
+    /**
+     * @brief Function to get the moves that lead to different positions. Moves that lead to a rotation or reflection of a position reached by an 
+     * earlier move are left out. On the empty board only a corner, an edge and the centre are left.
+     * @param toMove char. The player whose turn it is.
+     * @return uint16_t. Mask of free fields, only the first field in row and column order of each group of symmetric moves is set.
+     */
+    uint16_t distinctMoves(char toMove) const {
+        uint16_t result = 0;
+        uint32_t seen[9];
+        int count = 0;
+        for (uint16_t free = freeCells(); free; free &= free - 1){
+            int cell = __builtin_ctz(free);
+            BitBoard next = *this;
+            next.insert(cell, toMove);
+            int transform;
+            uint32_t canonical = next.canonicalIndex(transform);
+            if (std::find(seen, seen + count, canonical) == seen + count){
+                seen[count++] = canonical;
+                result |= uint16_t(1u << cell);
+            }
+        }
+        return result;
+    };
+};
+#ifdef TICTACTOE_SOLVED_TABLE
+/**
+ * @brief Table with the minimax score and best move of every base 3 encoding of the board, computed by the compiler.
+ * @class SolvedTable
+ *  A move only adds a digit, so every position has a higher index than the position before it. Going from the highest index down to 0, all positions
+ * after a move are already solved when a position is reached. Scores are from the point of view of the player to move, who is X if both have the same
+ * number of fields. The best move is the first field in row and column order with the best score, the same as findBestMove.
+ * Only built with -DTICTACTOE_SOLVED_TABLE, which the Makefile passes for minimax and minimax-bench.
+ */
+struct SolvedTable {
+    static constexpr uint32_t size = 19683;
+    int8_t value[size];
+    int8_t bestMove[size];
+    constexpr SolvedTable() : value(), bestMove() {
+        uint32_t power[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+        for (uint32_t index = size; index-- > 0;){
+            uint16_t x = 0;
+            uint16_t o = 0;
+            uint32_t rest = index;
+            for (int cell = 0; cell < 9; cell++){
+                if (rest % 3 == 1){
+                    x |= uint16_t(1u << cell);
+                } else if (rest % 3 == 2){
+                    o |= uint16_t(1u << cell);
+                }
+                rest /= 3;
+            }
+            bool xToMove = __builtin_popcount(x) == __builtin_popcount(o);
+            bestMove[index] = -1;
+            bool xWins = winTable.value[x];
+            bool oWins = winTable.value[o];
+            if (xWins || oWins){
+                value[index] = ((xWins && xToMove) || (oWins && !xToMove)) ? 10 : -10;
+                continue;
+            }
+            int best = -1000;
+            for (int cell = 0; cell < 9; cell++){
+                if ((x | o) & (1u << cell)){
+                    continue;
+                }
+                int score = -value[index + power[cell] * (xToMove ? 1 : 2)];
+                if (score > best){
+                    best = score;
+                    bestMove[index] = int8_t(cell);
+                }
+            }
+            value[index] = int8_t(bestMove[index] < 0 ? 0 : best);
+        }
+    };
+};
+/**
+ * @brief The solved game, part of the binary. Computed once in engine.cpp, so the other translation units do not have to run the constructor again.
+ */
+extern const SolvedTable solvedTable;
+#endif
+/**
+ * @brief Struct to find the terminal status of many BitBoards at once, with one kernel per instruction set and the best one picked at runtime.
+ * @struct TerminalKernel
+ *  The status of a board is a byte: XWins and OWins are set if the player has a full line, Draw if the board is full and nobody has one, 0 if the 
+ * game goes on. A board where both players have a line can not come up in a game and gets XWins | OWins.
+ *  A BitBoard is 4 bytes (x in the low, o in the high half of a 32 bit lane), so the SSE2 kernel does 4 and the AVX2 kernel 8 boards at once. Instead 
+ * of comparing with all 8 lines, the masks are shifted so the fields of every line land on the first field of the line (bit 0, 3, 6 for the rows, 
+ * bit 0, 1, 2 for the columns, bit 0 and 2 for the diagonals) and and-ed, which leaves a bit set for every full line. The rest of the array is done by 
+ * the next smaller kernel, the last boards by the scalar one, which uses winTable.
+ */
+struct TerminalKernel {
+    enum Status : uint8_t { Ongoing = 0, XWins = 1, OWins = 2, Draw = 4 };
+    typedef void (*Function)(const BitBoard* boards, uint8_t* status, size_t count);
+    const char* name;
+    Function run;
+    /**
+     * @brief Function to find the status of one board.
+     * @param board const BitBoard&. The board.
+     * @return uint8_t. The status.
+     */
+    static uint8_t statusOf(const BitBoard& board){
+        uint8_t status = uint8_t(winTable.value[board.x] | (winTable.value[board.o] << 1));
+        if (status == Ongoing && ((board.x | board.o) & BitBoard::full) == BitBoard::full){
+            status = Draw;
+        }
+        return status;
+    };
+    /**
+     * @brief Kernel without SIMD, one board at a time.
+     * @param boards const BitBoard*. The boards.
+     * @param status uint8_t*. Set to the status of every board.
+     * @param count size_t. The number of boards.
+     * @return void
+     */
+    static void scalar(const BitBoard* boards, uint8_t* status, size_t count);
+#if defined(__x86_64__) || defined(__i386__)
+    /**
+     * @brief Kernel for SSE2, 4 boards at a time.
+     * @param boards const BitBoard*. The boards.
+     * @param status uint8_t*. Set to the status of every board.
+     * @param count size_t. The number of boards.
+     * @return void
+     */
+    __attribute__((target("sse2")))
+    static void sse2(const BitBoard* boards, uint8_t* status, size_t count);
+    /**
+     * @brief Kernel for AVX2, 8 boards at a time.
+     * @param boards const BitBoard*. The boards.
+     * @param status uint8_t*. Set to the status of every board.
+     * @param count size_t. The number of boards.
+     * @return void
+     */
+    __attribute__((target("avx2")))
+    static void avx2(const BitBoard* boards, uint8_t* status, size_t count);
+#endif
+    /**
+     * @brief Function to get every kernel the CPU can run, the fastest last.
+     * @return std::vector<TerminalKernel>. The kernels.
+     */
+    static std::vector<TerminalKernel> available();
+    /**
+     * @brief Function to get the fastest kernel the CPU can run. Picked on the first call.
+     * @return const TerminalKernel&. The kernel.
+     */
+    static const TerminalKernel& best();
+};
+static_assert(sizeof(BitBoard) == 4, "The SIMD kernels load 4 byte BitBoards");
+/**
+ * @brief Class to represent a board of any size with any number of fields in a row needed to win (m,n,k game) in the compact form used by the search.
+ * @class MNKBoard
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ *  Like the BitBoard each player is a bitmask, with one bit per field (row*N + column). Instead of comparing against every line, insert only checks 
+ * the row, column and diagonals through the new field, so finding the winner does not depend on the size of the board. The board also keeps a Zobrist 
+ * hash of the position which is updated on every insert and refree and is used as the key for the transposition table.
+ * The search uses insert and refree like a stack, so only the field that completed the line has to be watched to take the winner back.
+ */
+template<int N, int K>
+class MNKBoard {
+public:
+    static constexpr int cells = N * N;
+    std::bitset<N * N> x;
+    std::bitset<N * N> o;
+    int count;
+    uint64_t hash;
+    char winner;
+    int winningCell;
+    /**
+     * @brief Constructor for the MNKBoard class. Initializes an empty board.
+     */
+    MNKBoard() : x(), o(), count(0), hash(0), winner(' '), winningCell(-1) {};
+    /**
+     * @brief Function to get the random number of a player on a field for the Zobrist hash.
+     * @param cell int. The field.
+     * @param c char. The player. 'X' for X, 'O' for O.
+     * @return uint64_t. The random number, the same for every run of the program.
+     */
+    static uint64_t zobrist(int cell, char c){
+        static const std::vector<uint64_t> keys = [](){
+            std::vector<uint64_t> values(2 * cells);
+            uint64_t state = 0x9E3779B97F4A7C15ull * (N * 31 + K);
+            for (uint64_t& value : values){
+                state += 0x9E3779B97F4A7C15ull;
+                uint64_t z = state;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                value = z ^ (z >> 31);
+            }
+            return values;
+        }();
+        return keys[2 * cell + (c == 'O' ? 1 : 0)];
+    };
+    /**
+     * @brief Function to compare two positions.
+     * @param other const MNKBoard&. The other board.
+     * @return bool. True if both players occupy the same fields on both boards.
+     */
+    bool operator==(const MNKBoard& other) const {
+        return x == other.x && o == other.o;
+    };
+    /**
+     * @brief Function to check if a field is free.
+     * @param cell int. The field to be checked (row*N + column).
+     * @return bool. True if the field is free, false if the field is occupied.
+     */
+    bool isFree(int cell) const {
+        return !x.test(cell) && !o.test(cell);
+    };
+    /**
+     * @brief Function to get all free fields at once.
+     * @return std::bitset. A bit is set for every free field.
+     */
+    std::bitset<N * N> freeCells() const {
+        return ~(x | o);
+    };
+    /**
+     * @brief Function to get the player whose turn it is. X always starts.
+     * @return char. 'X' if both have the same number of fields, 'O' otherwise.
+     */
+    char toMove() const {
+        return (count % 2 == 0) ? 'X' : 'O';
+    };
+    /**
+     * @brief Function to check if the row, column or one of the diagonals through a field has K fields of the player in a row.
+     * @param cell int. The field (row*N + column).
+     * @param c char. The player to be checked.
+     * @return bool. True if one of the 4 lines through the field is complete.
+     */
+    bool completesLine(int cell, char c) const {
+        static constexpr int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        const std::bitset<N * N>& mine = (c == 'X') ? x : o;
+        int row = cell / N;
+        int column = cell % N;
+        for (const auto& direction : directions){
+            int length = 1;
+            for (int sign = -1; sign <= 1; sign += 2){
+                int r = row + sign * direction[0];
+                int col = column + sign * direction[1];
+                while (length < K && r >= 0 && r < N && col >= 0 && col < N && mine.test(r * N + col)){
+                    length++;
+                    r += sign * direction[0];
+                    col += sign * direction[1];
+                }
+            }
+            if (length >= K){
+                return true;
+            }
+        }
+        return false;
+    };
+    /**
+     * @brief Function to insert a value into a field. Occupied fields are left untouched.
+     * @param cell int. The field to be inserted into (row*N + column).
+     * @param c char. The value to be inserted into the field. 'X' for X, 'O' for O.
+     * @return void
+     * If the field completes a line and there is no winner yet, the player becomes the winner.
+     */
+    void insert(int cell, char c){
+        if (!isFree(cell) || (c != 'X' && c != 'O')){
+            return;
+        }
+        (c == 'X' ? x : o).set(cell);
+        count++;
+        hash ^= zobrist(cell, c);
+        if (winner == ' ' && completesLine(cell, c)){
+            winner = c;
+            winningCell = cell;
+        }
+    };
+    /**
+     * @brief Function to remove a value from a field.
+     * @param cell int. The field to be removed from (row*N + column).
+     * @return void
+     * If the field is the one that won the game, there is no winner anymore.
+     */
+    void refree(int cell){
+        if (isFree(cell)){
+            return;
+        }
+        char c = x.test(cell) ? 'X' : 'O';
+        x.reset(cell);
+        o.reset(cell);
+        count--;
+        hash ^= zobrist(cell, c);
+        if (cell == winningCell){
+            winner = ' ';
+            winningCell = -1;
+        }
+    };
+    /**
+     * @brief Function to check if a player has won the game.
+     * @param c char. The player to be checked. 'X' for X, 'O' for O.
+     * @return bool. True if the player has K fields in a row.
+     */
+    bool isWinner(char c) const {
+        return winner == c;
+    };
+    /**
+     * @brief Function to check if the game is a draw.
+     * @return bool. True if all fields are occupied.
+     */
+    bool isDraw() const {
+        return count == cells;
+    };
+};
+/**
+ * @brief Class to store the results of positions that were already searched by minimax.
+ * @class TranspositionTable
+ *  The same position can be reached through different move orders. The first time it is searched, its score is stored with the key of the position and 
+ * whether it is the exact score or only a lower or upper bound. The next time the position is reached the score is read from the table instead of searching again.
+ * Scores are always stored from the point of view of the player to move. Entries are replaced when a different position maps to the same slot.
+ * The search uses the key of the canonical position, so all rotations and reflections of a position share one entry and the stored best move is in 
+ * the orientation of the canonical position.
+ * The table can be shared by several threads without locks: every entry is two 64 bit words, the packed data and the key xor the data. A reader only 
+ * accepts an entry if both words belong together, so an entry that is torn by two threads writing at the same time is treated as missing.
+ */
+class TranspositionTable {
+public:
+    /**
+     * @brief Type of the stored score.
+     */
+    enum Bound : uint8_t { Empty, Exact, Lower, Upper };
+    /**
+     * @brief Struct to represent a single entry of the table.
+     */
+    struct Entry {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+        Entry() : check(0), data(0) {};
+    };
+    /**
+     * @brief Struct to represent the unpacked data of an entry.
+     */
+    struct Data {
+        int value;
+        int bestMove;
+        Bound bound;
+        int depth;
+    };
+    std::vector<Entry> entries;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    /**
+     * @brief Constructor for the TranspositionTable class.
+     * @param capacity size_t. The number of entries. With 2*3^9 entries every 3x3 position has its own slot.
+     */
+    TranspositionTable(size_t capacity = 2 * 19683) : entries(capacity), hits(0), misses(0) {};
+    /**
+     * @brief Function to read the entry of a position.
+     * @param key uint64_t. The key of the position.
+     * @param result Data&. Set to the stored data.
+     * @return bool. True if the position is in the table.
+     */
+    bool read(uint64_t key, Data& result) const {
+        const Entry& entry = entries[key % entries.size()];
+        uint64_t data = entry.data.load(std::memory_order_relaxed);
+        uint64_t check = entry.check.load(std::memory_order_relaxed);
+        result.bound = Bound((data >> 32) & 0xFF);
+        if ((check ^ data) != key || result.bound == Empty){
+            return false;
+        }
+        result.value = int16_t(data & 0xFFFF);
+        result.bestMove = int16_t((data >> 16) & 0xFFFF);
+        result.depth = int((data >> 40) & 0xFF);
+        return true;
+    };
+    /**
+     * @brief Function to get the best move stored for a position, even if its score can not be used. Used to search this move first.
+     * @param key uint64_t. The key of the position.
+     * @return int. The stored field, -1 if the position is not in the table.
+     */
+    int bestMove(uint64_t key) const {
+        Data data;
+        if (read(key, data)){
+            return data.bestMove;
+        }
+        return -1;
+    };
+    /**
+     * @brief Function to look up a position.
+     * @param key uint64_t. The key of the position.
+     * @param alpha int. The lower end of the search window.
+     * @param beta int. The upper end of the search window.
+     * @param value int&. Set to the stored score if it can be used.
+     * @param depth int. The number of moves the search would look ahead. Scores that were searched less deep are not used.
+     * @return bool. True if the stored score is exact or a bound that already lies outside of the window, false otherwise.
+     */
+    bool probe(uint64_t key, int alpha, int beta, int& value, int depth = 0){
+        Data entry;
+        if (read(key, entry) && entry.depth >= depth){
+            if (entry.bound == Exact || (entry.bound == Lower && entry.value >= beta) || (entry.bound == Upper && entry.value <= alpha)){
+                value = entry.value;
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    };
+    /**
+     * @brief Function to store the result of a search.
+     * @param key uint64_t. The key of the position.
+     * @param value int. The score from the point of view of the player to move.
+     * @param bound Bound. Whether the score is exact, a lower bound or an upper bound.
+     * @param bestMove int. The field of the best move found, -1 if there is none.
+     * @param depth int. The number of moves the search looked ahead. 0 for the 3x3 search, which always searches to the end of the game.
+     * @return void
+     */
+    void store(uint64_t key, int value, Bound bound, int bestMove, int depth = 0){
+        Entry& entry = entries[key % entries.size()];
+        uint64_t data = uint64_t(uint16_t(value)) | (uint64_t(uint16_t(bestMove)) << 16) | (uint64_t(bound) << 32) | (uint64_t(uint8_t(depth)) << 40);
+        entry.data.store(data, std::memory_order_relaxed);
+        entry.check.store(key ^ data, std::memory_order_relaxed);
+    };
+    /**
+     * @brief Function to remove all entries and reset the counters.
+     * @return void
+     */
+    void clear();
+    /**
+     * @brief Getter for the table that is shared by all computer players. It is kept for the whole run of the program, so it is reused between moves and games.
+     * @return TranspositionTable&. The shared table.
+     */
+    static TranspositionTable& shared();
+};
+/**
+ * @brief Class to represent the solved game, loaded from a file that contains the best move and score for every position.
+ * @class OpeningBook
+ *  The file is written by generateOpeningBook and starts with a header (magic, format version, number of entries and a FNV-1a checksum of the entries).
+ * After the header there is one Entry per base 3 index of a position. Positions that can not be reached or are already finished have no move.
+ * The file is memory mapped, so a lookup is a single array access. If the file is missing, has a different version or the checksum does not match, 
+ * nothing is loaded and the computer player falls back to the search.
+ */
+class OpeningBook {
+public:
+    /**
+     * @brief Struct to represent the header at the start of the file.
+     */
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t checksum;
+    };
+    /**
+     * @brief Struct to represent a single position. The score is from the point of view of the player to move.
+     */
+    struct Entry {
+        int8_t value;
+        int8_t bestMove;
+    };
+    static constexpr char magic[4] = {'T', 'T', 'T', 'B'};
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t entryCount = 19683;
+    const Entry* entries;
+    void* mapping;
+    size_t mappingSize;
+    /**
+     * @brief Constructor for the OpeningBook class. Initializes an empty book.
+     */
+    OpeningBook() : entries(nullptr), mapping(nullptr), mappingSize(0) {};
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+    /**
+     * @brief Destructor for the OpeningBook class. Unmaps the file.
+     */
+    ~OpeningBook(){
+        unload();
+    };
+    /**
+     * @brief Function to compute the checksum of the entries.
+     * @param data const void*. The entries.
+     * @param size size_t. The size of the entries in bytes.
+     * @return uint32_t. The 32 bit FNV-1a hash of the data.
+     */
+    static uint32_t checksum(const void* data, size_t size);
+    /**
+     * @brief Function to memory map a book file.
+     * @param path const char*. The path of the file.
+     * @return bool. True if the file was loaded, false if it is missing or corrupt. In that case the book stays empty.
+     */
+    bool load(const char* path);
+    /**
+     * @brief Function to unmap the file.
+     * @return void
+     */
+    void unload();
+    /**
+     * @brief Function to check if a book is loaded.
+     * @return bool. True if a valid file was loaded.
+     */
+    bool isLoaded() const {
+        return entries != nullptr;
+    };
+    /**
+     * @brief Function to look up the best move of a position.
+     * @param currentBoard const BitBoard&. The current game board.
+     * @param c char. The player to move. The book assumes X starts, so if the player does not match the number of X and O on the board nothing is returned.
+     * @param cell int&. Set to the best field.
+     * @param value int8_t*. Set to the score of the position for the player to move (10 win, 0 draw, -10 loss), if not nullptr.
+     * @return bool. True if the book has a move for the position.
+     */
+    bool lookup(const BitBoard& currentBoard, char c, int& cell, int8_t* value = nullptr) const;
+    /**
+     * @brief Function to write a book file.
+     * @param path const char*. The path of the file.
+     * @param table const std::vector<Entry>&. One entry per base 3 index.
+     * @return bool. True if the file was written.
+     */
+    static bool save(const char* path, const std::vector<Entry>& table);
+    /**
+     * @brief Getter for the book that is used by all computer players. Loaded once at startup in main.
+     * @return OpeningBook&. The shared book.
+     */
+    static OpeningBook& shared();
+};
+/**
+ * @brief Class to solve every position of an m,n,k game backwards from the end (retrograde analysis) and to look up perfect moves in the result.
+ * @class Tablebase
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ *  There is one byte per base 3 index of the board (0 free, 1 X, 2 O, field 0 is the lowest digit like BitBoard::index). The low 2 bits are the 
+ * Result for the player to move, the other 6 bits the number of moves until the game ends with perfect play: the winner wins as fast as possible, 
+ * the loser holds out as long as possible, a draw goes on until the board is full. Positions that can not come up in a game are Invalid.
+ *  generate first marks every legal position. Finished games are the first frontier: a board with a line is lost for the player to move, a full 
+ * board is a draw. Every legal position that is not finished gets a counter with its number of moves. Then the frontier is walked backwards one 
+ * move at a time: the positions before a lost position are won one move later, the positions before a won position count down their counter and 
+ * are lost once all of their moves lead to a win of the opponent. Since the frontier of distance d is done before d + 1, the first loss found is 
+ * the fastest win and the last win found is the slowest loss. What is left over at the end is a draw. The frontier is split between the threads 
+ * in blocks, the counters and results are atomics.
+ *  The file is a Header followed by the bytes and is memory mapped, so only the pages of positions that come up in a game are read. The index has to 
+ * fit into 32 bits, which allows boards with up to 16 fields (4x4: 43 million positions). Larger boards can not have a tablebase.
+ */
+template<int N, int K>
+class Tablebase {
+public:
+    /**
+     * @brief Struct to represent the header at the start of the file.
+     */
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t size;
+        uint32_t inRow;
+        uint64_t entryCount;
+        uint32_t checksum;
+        uint32_t reserved;
+    };
+    /**
+     * @brief The result of a position for the player to move.
+     */
+    enum Result : uint8_t { Invalid = 0, Win = 1, Loss = 2, Draw = 3 };
+    static constexpr int cells = N * N;
+    static constexpr bool supported = cells <= 16;
+    static constexpr char magic[4] = {'T', 'T', 'T', 'E'};
+    static constexpr uint32_t version = 1;
+    static constexpr size_t blockSize = 4096;
+    const uint8_t* entries;
+    void* mapping;
+    size_t mappingSize;
+    /**
+     * @brief Constructor for the Tablebase class. Initializes an empty tablebase.
+     */
+    Tablebase() : entries(nullptr), mapping(nullptr), mappingSize(0) {};
+    Tablebase(const Tablebase&) = delete;
+    Tablebase& operator=(const Tablebase&) = delete;
+    /**
+     * @brief Destructor for the Tablebase class. Unmaps the file.
+     */
+    ~Tablebase(){
+        unload();
+    };
+    /**
+     * @brief Function to build the byte of a position.
+     * @param result Result. The result for the player to move.
+     * @param distance int. The number of moves until the game ends.
+     * @return uint8_t. The byte.
+     */
+    static constexpr uint8_t entry(Result result, int distance){
+        return uint8_t(result | (distance << 2));
+    };
+    /**
+     * @brief Function to get the result of a position from its byte.
+     * @param value uint8_t. The byte.
+     * @return Result. The result for the player to move.
+     */
+    static Result result(uint8_t value){
+        return Result(value & 3);
+    };
+    /**
+     * @brief Function to get the number of moves until the game ends from the byte of a position.
+     * @param value uint8_t. The byte.
+     * @return int. The number of moves.
+     */
+    static int distance(uint8_t value){
+        return value >> 2;
+    };
+    /**
+     * @brief Function to get the number of positions, 3 to the power of the number of fields.
+     * @return uint64_t. The number of positions.
+     */
+    static uint64_t entryCount(){
+        uint64_t count = 1;
+        for (int cell = 0; cell < cells; cell++){
+            count *= 3;
+        }
+        return count;
+    };
+    /**
+     * @brief Function to get the value of a digit of the index.
+     * @param cell int. The field.
+     * @return uint32_t. 3 to the power of cell.
+     */
+    static uint32_t power(int cell){
+        static const std::vector<uint32_t> powers = [](){
+            std::vector<uint32_t> values(cells, 1);
+            for (int i = 1; i < cells; i++){
+                values[i] = values[i-1] * 3;
+            }
+            return values;
+        }();
+        return powers[cell];
+    };
+    /**
+     * @brief Function to get a mask for every segment of K fields in a row, column or diagonal.
+     * @return const std::vector<uint32_t>&. The masks, bit (row*N + column) is set for every field of the segment.
+     */
+    static const std::vector<uint32_t>& lineMasks(){
+        static const std::vector<uint32_t> masks = [](){
+            static constexpr int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+            std::vector<uint32_t> values;
+            for (int cell = 0; cell < cells; cell++){
+                for (const auto& direction : directions){
+                    int lastRow = cell / N + (K - 1) * direction[0];
+                    int lastColumn = cell % N + (K - 1) * direction[1];
+                    if (lastRow < 0 || lastRow >= N || lastColumn < 0 || lastColumn >= N){
+                        continue;
+                    }
+                    uint32_t mask = 0;
+                    for (int i = 0; i < K; i++){
+                        mask |= 1u << ((cell / N + i * direction[0]) * N + cell % N + i * direction[1]);
+                    }
+                    values.push_back(mask);
+                }
+            }
+            return values;
+        }();
+        return masks;
+    };
+    /**
+     * @brief Function to check if the fields of a player contain a full line.
+     * @param fields uint32_t. The fields of the player, one bit per field.
+     * @return bool. True if K fields in a row are set.
+     */
+    static bool hasLine(uint32_t fields){
+        for (uint32_t line : lineMasks()){
+            if ((fields & line) == line){
+                return true;
+            }
+        }
+        return false;
+    };
+    /**
+     * @brief Function to get the fields of both players from the index of a position.
+     * @param index uint32_t. The base 3 index.
+     * @param x uint32_t&. Set to the fields of X.
+     * @param o uint32_t&. Set to the fields of O.
+     * @return void
+     */
+    static void decode(uint32_t index, uint32_t& x, uint32_t& o){
+        x = 0;
+        o = 0;
+        for (int cell = 0; cell < cells; cell++, index /= 3){
+            if (index % 3 == 1){
+                x |= 1u << cell;
+            } else if (index % 3 == 2){
+                o |= 1u << cell;
+            }
+        }
+    };
+    /**
+     * @brief Function to get the index of a position.
+     * @param board const MNKBoard<N, K>&. The board.
+     * @return uint32_t. The base 3 index.
+     */
+    static uint32_t indexOf(const MNKBoard<N, K>& board){
+        uint32_t index = 0;
+        for (int cell = 0; cell < cells; cell++){
+            if (board.x.test(cell)){
+                index += power(cell);
+            } else if (board.o.test(cell)){
+                index += 2 * power(cell);
+            }
+        }
+        return index;
+    };
+    /**
+     * @brief Function to run a function on all blocks of a range with several threads.
+     * @tparam Body class. Callable with the number of the thread and the start and end of the block.
+     * @param count size_t. The size of the range.
+     * @param threads int. The number of threads.
+     * @param body Body. The function.
+     * @return void
+     */
+    template<class Body>
+    static void forEachBlock(size_t count, int threads, Body body){
+        threads = int(std::min<size_t>(size_t(threads), (count + blockSize - 1) / blockSize));
+        std::atomic<size_t> nextBlock(0);
+        auto worker = [&](int id){
+            for (size_t start = nextBlock.fetch_add(blockSize); start < count; start = nextBlock.fetch_add(blockSize)){
+                body(id, start, std::min(start + blockSize, count));
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int i = 1; i < threads; i++){
+            pool.emplace_back(worker, i);
+        }
+        worker(0);
+        for (std::thread& thread : pool){
+            thread.join();
+        }
+    };
+    /**
+     * @brief Function to solve every position with retrograde analysis.
+     * @param threads int. The number of threads, 0 for one per core.
+     * @return std::vector<uint8_t>. One byte per base 3 index.
+     */
+    static std::vector<uint8_t> generate(int threads){
+        static_assert(supported, "The index of the tablebase has to fit into 32 bits");
+        if (threads <= 0){
+            threads = std::max(1, int(std::thread::hardware_concurrency()));
+        }
+        const size_t count = size_t(entryCount());
+        std::unique_ptr<std::atomic<uint8_t>[]> table(new std::atomic<uint8_t>[count]);
+        std::unique_ptr<std::atomic<uint8_t>[]> pending(new std::atomic<uint8_t>[count]);
+        std::vector<std::vector<uint32_t>> found(threads);
+        forEachBlock(count, threads, [&](int id, size_t start, size_t end){
+            for (size_t index = start; index < end; index++){
+                uint32_t x;
+                uint32_t o;
+                decode(uint32_t(index), x, o);
+                int xCount = __builtin_popcount(x);
+                int oCount = __builtin_popcount(o);
+                uint32_t last = (xCount > oCount) ? x : o;
+                uint32_t next = (xCount > oCount) ? o : x;
+                uint8_t value = Invalid;
+                uint8_t moves = 0;
+                if (xCount - oCount < 0 || xCount - oCount > 1 || hasLine(next)){
+                    // Not the turn of X or O, or the game ended before the last move.
+                } else if (hasLine(last)){
+                    // Only legal if the line came with the last move, so there has to be a field without which there is no line.
+                    for (uint32_t rest = last; rest; rest &= rest - 1){
+                        if (!hasLine(last & ~(rest & -rest))){
+                            value = entry(Loss, 0);
+                            found[id].push_back(uint32_t(index));
+                            break;
+                        }
+                    }
+                } else if (xCount + oCount == cells){
+                    value = entry(Draw, 0);
+                } else {
+                    moves = uint8_t(cells - xCount - oCount);
+                }
+                table[index].store(value, std::memory_order_relaxed);
+                pending[index].store(moves, std::memory_order_relaxed);
+            }
+        });
+        std::vector<uint32_t> frontier;
+        for (int distance = 0; ; distance++){
+            frontier.clear();
+            for (std::vector<uint32_t>& positions : found){
+                frontier.insert(frontier.end(), positions.begin(), positions.end());
+                positions.clear();
+            }
+            if (frontier.empty()){
+                break;
+            }
+            forEachBlock(frontier.size(), threads, [&](int id, size_t start, size_t end){
+                for (size_t i = start; i < end; i++){
+                    uint32_t index = frontier[i];
+                    uint32_t x;
+                    uint32_t o;
+                    decode(index, x, o);
+                    bool lost = result(table[index].load(std::memory_order_relaxed)) == Loss;
+                    bool xMovedLast = __builtin_popcount(x) > __builtin_popcount(o);
+                    uint32_t last = xMovedLast ? x : o;
+                    uint32_t digit = xMovedLast ? 1 : 2;
+                    for (uint32_t rest = last; rest; rest &= rest - 1){
+                        int cell = __builtin_ctz(rest);
+                        if (hasLine(last & ~(1u << cell))){
+                            continue;
+                        }
+                        uint32_t previous = index - digit * power(cell);
+                        if (lost){
+                            uint8_t expected = Invalid;
+                            if (table[previous].compare_exchange_strong(expected, entry(Win, distance + 1), std::memory_order_relaxed)){
+                                found[id].push_back(previous);
+                            }
+                        } else if (pending[previous].fetch_sub(1, std::memory_order_relaxed) == 1){
+                            table[previous].store(entry(Loss, distance + 1), std::memory_order_relaxed);
+                            found[id].push_back(previous);
+                        }
+                    }
+                }
+            });
+        }
+        std::vector<uint8_t> solved(count);
+        forEachBlock(count, threads, [&](int, size_t start, size_t end){
+            for (size_t index = start; index < end; index++){
+                uint8_t value = table[index].load(std::memory_order_relaxed);
+                if (value == Invalid && pending[index].load(std::memory_order_relaxed) > 0){
+                    uint32_t x;
+                    uint32_t o;
+                    decode(uint32_t(index), x, o);
+                    value = entry(Draw, cells - __builtin_popcount(x | o));
+                }
+                solved[index] = value;
+            }
+        });
+        return solved;
+    };
+    /**
+     * @brief Function to memory map a tablebase file.
+     * @param path const char*. The path of the file.
+     * @return bool. True if the file was loaded, false if it is missing, corrupt or for another board. In that case the tablebase stays empty.
+     */
+    bool load(const char* path){
+        unload();
+        if (!supported){
+            return false;
+        }
+        int fd = open(path, O_RDONLY);
+        if (fd < 0){
+            return false;
+        }
+        struct stat info;
+        size_t expected = sizeof(Header) + size_t(entryCount());
+        if (fstat(fd, &info) != 0 || size_t(info.st_size) != expected){
+            close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED){
+            return false;
+        }
+        const Header* header = static_cast<const Header*>(data);
+        const uint8_t* table = reinterpret_cast<const uint8_t*>(header + 1);
+        if (std::memcmp(header->magic, magic, 4) != 0 || header->version != version || header->size != N || header->inRow != K 
+            || header->entryCount != entryCount() || header->checksum != OpeningBook::checksum(table, size_t(entryCount()))){
+            munmap(data, expected);
+            return false;
+        }
+        mapping = data;
+        mappingSize = expected;
+        entries = table;
+        return true;
+    };
+    /**
+     * @brief Function to unmap the file.
+     * @return void
+     */
+    void unload(){
+        if (mapping){
+            munmap(mapping, mappingSize);
+        }
+        entries = nullptr;
+        mapping = nullptr;
+        mappingSize = 0;
+    };
+    /**
+     * @brief Function to check if a tablebase is loaded.
+     * @return bool. True if a valid file was loaded.
+     */
+    bool isLoaded() const {
+        return entries != nullptr;
+    };
+    /**
+     * @brief Function to look up a perfect move.
+     * @param board const MNKBoard<N, K>&. The current game board. The player to move follows from the number of X and O.
+     * @param cell int&. Set to the lowest field that keeps the result and the distance of the position.
+     * @param value uint8_t&. Set to the byte of the position.
+     * @return bool. True if the tablebase has a move for the position, false if none is loaded or the game is over.
+     */
+    bool lookup(const MNKBoard<N, K>& board, int& cell, uint8_t& value) const {
+        if (!entries){
+            return false;
+        }
+        uint32_t index = indexOf(board);
+        value = entries[index];
+        if (result(value) == Invalid || distance(value) == 0){
+            return false;
+        }
+        uint32_t digit = (board.toMove() == 'X') ? 1 : 2;
+        Result answer = (result(value) == Win) ? Loss : (result(value) == Loss) ? Win : Draw;
+        for (int next = 0; next < cells; next++){
+            if (!board.isFree(next)){
+                continue;
+            }
+            uint8_t child = entries[index + digit * power(next)];
+            if (result(child) == answer && distance(child) == distance(value) - 1){
+                cell = next;
+                return true;
+            }
+        }
+        return false;
+    };
+    /**
+     * @brief Function to write a tablebase file.
+     * @param path const char*. The path of the file.
+     * @param table const std::vector<uint8_t>&. One byte per base 3 index, as returned by generate.
+     * @return bool. True if the file was written.
+     */
+    static bool save(const char* path, const std::vector<uint8_t>& table){
+        if (table.size() != entryCount()){
+            return false;
+        }
+        Header header;
+        std::memcpy(header.magic, magic, 4);
+        header.version = version;
+        header.size = N;
+        header.inRow = K;
+        header.entryCount = table.size();
+        header.checksum = OpeningBook::checksum(table.data(), table.size());
+        header.reserved = 0;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()), std::streamsize(table.size()));
+        return bool(out);
+    };
+    /**
+     * @brief Getter for the tablebase that is used by all searches on this board. Loaded once at startup in main.
+     * @return Tablebase&. The shared tablebase.
+     */
+    static Tablebase& shared(){
+        static Tablebase tablebase;
+        return tablebase;
+    };
+};
+#ifdef TICTACTOE_STATS
+#define SEARCH_STAT(statement) statement
+#else
+#define SEARCH_STAT(statement)
+#endif
+/**
+ * @brief Struct to represent what a search did. The counters are only filled when the program is compiled with -DTICTACTOE_STATS, otherwise 
+ * SEARCH_STAT removes them and only the nodes and the time are set.
+ */
+struct SearchStats {
+    uint64_t nodes;
+    uint64_t leaves;
+    uint64_t tableHits;
+    uint64_t cutoffs;
+    uint64_t expanded;
+    uint64_t children;
+    int maxDepth;
+    double seconds;
+    /**
+     * @brief Constructor for the SearchStats struct. All counters start at 0.
+     */
+    SearchStats() : nodes(0), leaves(0), tableHits(0), cutoffs(0), expanded(0), children(0), maxDepth(0), seconds(0) {};
+    /**
+     * @brief Function to get the average number of moves searched in every position that was not a leaf.
+     * @return double. The branching factor, 0 if no position was expanded.
+     */
+    double branchingFactor() const {
+        return expanded ? double(children) / double(expanded) : 0.0;
+    };
+    /**
+     * @brief Function to add the counters of another search, e.g. of another move or another thread.
+     * @param other const SearchStats&. The other search.
+     * @return void
+     */
+    void merge(const SearchStats& other){
+        nodes += other.nodes;
+        leaves += other.leaves;
+        tableHits += other.tableHits;
+        cutoffs += other.cutoffs;
+        expanded += other.expanded;
+        children += other.children;
+        maxDepth = std::max(maxDepth, other.maxDepth);
+        seconds += other.seconds;
+    };
+    /**
+     * @brief Function to print the statistics in one line. Without -DTICTACTOE_STATS only the nodes and the time are printed.
+     * @param out std::ostream&. The stream to print to.
+     * @param counted const char*. The name of what nodes counts, "iterations" for MCTS.
+     * @return void
+     */
+    void print(std::ostream& out, const char* counted = "nodes") const;
+};
+/**
+ * @brief Struct to measure the wall time of a search. Adds the time since its construction to the stats when it is destroyed, so every return of 
+ * the search is timed.
+ */
+struct SearchTimer {
+    SearchStats& stats;
+    std::chrono::steady_clock::time_point start;
+    /**
+     * @brief Constructor for the SearchTimer struct. Starts the clock.
+     * @param pstats SearchStats&. The stats that get the time.
+     */
+    SearchTimer(SearchStats& pstats) : stats(pstats), start(std::chrono::steady_clock::now()) {};
+    /**
+     * @brief Destructor for the SearchTimer struct. Stops the clock.
+     */
+    ~SearchTimer(){
+        stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+};
+/**
+ * @brief Struct to stop a search from another thread or at a hard deadline.
+ *  A search that gets a token checks it every 1024 nodes, from the first iteration on, and returns the best move it has so far. The other limits of 
+ * SearchLimits only apply after the first iteration, so a token is the way to bound the time of a move for sure.
+ */
+struct CancellationToken {
+    std::atomic<bool> cancelled;
+    std::atomic<std::chrono::steady_clock::rep> deadline;
+    /**
+     * @brief Constructor for the CancellationToken struct. Initializes a token without a deadline.
+     */
+    CancellationToken() : cancelled(false), deadline(std::chrono::steady_clock::time_point::max().time_since_epoch().count()) {};
+    /**
+     * @brief Function to make the token usable for the next search.
+     * @param seconds double. The time from now until the token cancels itself, 0 for no deadline.
+     * @return void
+     */
+    void reset(double seconds = 0){
+        auto end = std::chrono::steady_clock::time_point::max();
+        if (seconds > 0){
+            end = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+        }
+        deadline.store(end.time_since_epoch().count(), std::memory_order_relaxed);
+        cancelled.store(false, std::memory_order_relaxed);
+    };
+    /**
+     * @brief Function to stop the search that uses the token.
+     * @return void
+     */
+    void cancel(){
+        cancelled.store(true, std::memory_order_relaxed);
+    };
+    /**
+     * @brief Function to check if the search has to stop.
+     * @return bool. True if the token was cancelled or the deadline has passed.
+     */
+    bool isCancelled() const {
+        return cancelled.load(std::memory_order_relaxed) 
+            || std::chrono::steady_clock::now().time_since_epoch().count() >= deadline.load(std::memory_order_relaxed);
+    };
+};
+/**
+ * @brief Struct to represent the budget of a search. A limit of 0 means no limit.
+ */
+struct SearchLimits {
+    double seconds;
+    uint64_t nodes;
+    int depth;
+    const CancellationToken* token;
+    /**
+     * @brief Constructor for the SearchLimits struct.
+     * @param pseconds double. The time for one move in seconds.
+     * @param pnodes uint64_t. The number of nodes for one move.
+     * @param pdepth int. The maximum number of moves to look ahead.
+     * @param ptoken const CancellationToken*. The token that stops the search, nullptr for none.
+     */
+    SearchLimits(double pseconds = 0, uint64_t pnodes = 0, int pdepth = 0, const CancellationToken* ptoken = nullptr) : seconds(pseconds), nodes(pnodes), 
+        depth(pdepth), token(ptoken) {};
+};
+/**
+ * @brief Class to run a search on a background thread while the opponent thinks (pondering) and to stop it again.
+ * @class PonderThread
+ *  The search gets token in its SearchLimits, stop cancels it and waits for the thread, so the search can be used again right after.
+ */
+class PonderThread {
+public:
+    std::thread thread;
+    CancellationToken token;
+    /**
+     * @brief Constructor for the PonderThread class.
+     */
+    PonderThread(){};
+    PonderThread(const PonderThread&) = delete;
+    PonderThread& operator=(const PonderThread&) = delete;
+    /**
+     * @brief Destructor for the PonderThread class. Stops the search.
+     */
+    ~PonderThread(){
+        stop();
+    };
+    /**
+     * @brief Function to start a search in the background. A search that is still running is stopped first.
+     * @tparam Search class. Callable that runs the search with token.
+     * @param search Search. The search.
+     * @return void
+     */
+    template<class Search>
+    void start(Search search){
+        stop();
+        token.reset();
+        thread = std::thread(search);
+    };
+    /**
+     * @brief Function to cancel the search and wait until it has returned.
+     * @return void
+     */
+    void stop();
+};
+template<int N, int K>
+class ParallelMNKSearch;
+/**
+ * @brief Struct to represent a node whose moves are searched by several threads.
+ * @tparam Board class. The type of the board.
+ *  The thread that creates the split point waits until all moves are searched. Every thread that searches one of the moves updates the best score 
+ * under the mutex and sets cutoff when the score reaches beta, which stops the threads still searching the other moves.
+ */
+template<class Board>
+struct SplitPoint {
+    Board board;
+    SplitPoint* parent;
+    int ply;
+    int depth;
+    int alpha;
+    int beta;
+    std::mutex mutex;
+    int best;
+    int bestCell;
+    int bestRank;
+    std::atomic<bool> cutoff;
+    std::atomic<int> pending;
+    /**
+     * @brief Constructor for the SplitPoint struct.
+     * @param pboard const Board&. The board of the node.
+     * @param pparent SplitPoint*. The split point the creating thread works under, nullptr if there is none.
+     * @param pply int. The number of moves made since the start of the search.
+     * @param pdepth int. The number of moves left to look ahead.
+     * @param palpha int. The lower end of the search window.
+     * @param pbeta int. The upper end of the search window.
+     * @param pbest int. The best score so far.
+     * @param pbestCell int. The best field so far.
+     * @param pbestRank int. The rank of the best field so far.
+     */
+    SplitPoint(const Board& pboard, SplitPoint* pparent, int pply, int pdepth, int palpha, int pbeta, int pbest, int pbestCell, int pbestRank)
+        : board(pboard), parent(pparent), ply(pply), depth(pdepth), alpha(palpha), beta(pbeta), best(pbest), bestCell(pbestCell), bestRank(pbestRank),
+        cutoff(pbest >= pbeta), pending(0) {};
+};
+/**
+ * @brief Struct to represent one move of a split point that is waiting for a thread.
+ * @tparam Board class. The type of the board.
+ */
+template<class Board>
+struct SearchTask {
+    SplitPoint<Board>* split;
+    int cell;
+    int rank;
+};
+/**
+ * @brief Class to search the best move on an MNKBoard.
+ * @class MNKSearch
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ *  The search is minimax with alpha-beta pruning written as negamax, so the score is always from the point of view of the player to move. A win is worth 
+ * 1000 plus the number of free fields left, so faster wins are preferred. Since the number of free fields is part of the position, the score can be 
+ * stored in the transposition table which is keyed by the Zobrist hash. Moves are tried in the order: principal variation of the last iteration, best 
+ * move from the table, killer move, history and then the fields closest to the centre first.
+ * On larger boards the game tree is too big to search to the end, so findBestMove uses iterative deepening: it searches 1, 2, 3, ... moves ahead until 
+ * the time or node budget is used up and returns the best move of the deepest search that finished. Positions at the end of the search are scored by
+ * evaluate, which counts the lines that are still open for each player.
+ * If a Tablebase for the board is loaded, findBestMove plays its move without searching.
+ * An MNKSearch can be one of the threads of a ParallelMNKSearch. It then has its own copy of the board, killer moves and history, shares the 
+ * transposition table with the other threads and splits the moves of deep nodes with them.
+ */
+template<int N, int K>
+class MNKSearch {
+public:
+    using Board = MNKBoard<N, K>;
+    static constexpr int cells = N * N;
+    static constexpr int winScore = 1000;
+    static constexpr int maxEvaluation = 900;
+    static constexpr bool localMoves = N > 2 * K;
+    std::shared_ptr<TranspositionTable> table;
+    const Tablebase<N, K>* tablebase;
+    ParallelMNKSearch<N, K>* pool;
+    int id;
+    SplitPoint<Board>* currentSplit;
+    uint64_t nodes;
+    uint64_t reportedNodes;
+    SearchStats stats;
+    uint64_t nextClockCheck;
+    int killers[cells + 1];
+    uint32_t history[2][cells];
+    int centre[cells];
+    std::vector<std::bitset<N * N>> lines;
+    std::vector<std::vector<int>> linesThrough;
+    std::vector<int> xInLine;
+    std::vector<int> oInLine;
+    int openLines;
+    std::bitset<N * N> notFirstColumn;
+    std::bitset<N * N> notLastColumn;
+    std::vector<int> pv;
+    int completedDepth;
+    int lastScore;
+    bool stopped;
+    SearchLimits limits;
+    const CancellationToken* token;
+    std::chrono::steady_clock::time_point deadline;
+    /**
+     * @brief Constructor for the MNKSearch class.
+     * @param tableSize size_t. The number of entries of the transposition table.
+     */
+    MNKSearch(size_t tableSize = size_t(1) << 20) : MNKSearch(std::make_shared<TranspositionTable>(tableSize)) {};
+    /**
+     * @brief Constructor for the MNKSearch class with a transposition table that is shared with other searches, e.g. the other threads of a 
+     * ParallelMNKSearch.
+     * @param ptable std::shared_ptr<TranspositionTable>. The table.
+     * @param ppool ParallelMNKSearch<N, K>*. The threads to split the search with, nullptr to search on this thread only.
+     * @param pid int. The number of this search in the pool.
+     * Collects every segment of K fields in a row, column or diagonal for evaluate.
+     */
+    MNKSearch(std::shared_ptr<TranspositionTable> ptable, ParallelMNKSearch<N, K>* ppool = nullptr, int pid = 0) : table(ptable), tablebase(&Tablebase<N, K>::shared()), pool(ppool), id(pid), 
+        currentSplit(nullptr), nodes(0), reportedNodes(0), nextClockCheck(0), linesThrough(N * N), openLines(0), completedDepth(0), lastScore(0), stopped(false), 
+        token(nullptr) {
+        std::fill(killers, killers + cells + 1, -1);
+        std::fill(&history[0][0], &history[0][0] + 2 * cells, 0u);
+        static constexpr int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (int cell = 0; cell < cells; cell++){
+            centre[cell] = 2 * N - std::abs(2 * (cell / N) - (N - 1)) - std::abs(2 * (cell % N) - (N - 1));
+            notFirstColumn.set(cell, cell % N != 0);
+            notLastColumn.set(cell, cell % N != N - 1);
+            for (const auto& direction : directions){
+                int lastRow = cell / N + (K - 1) * direction[0];
+                int lastColumn = cell % N + (K - 1) * direction[1];
+                if (lastRow < 0 || lastRow >= N || lastColumn < 0 || lastColumn >= N){
+                    continue;
+                }
+                std::bitset<N * N> line;
+                for (int i = 0; i < K; i++){
+                    int member = (cell / N + i * direction[0]) * N + cell % N + i * direction[1];
+                    line.set(member);
+                    linesThrough[member].push_back(int(lines.size()));
+                }
+                lines.push_back(line);
+            }
+        }
+        xInLine.assign(lines.size(), 0);
+        oInLine.assign(lines.size(), 0);
+    };
+    /**
+     * @brief Function to get the worth of a segment of K fields for evaluate.
+     * @param xCount int. The number of fields of X in the segment.
+     * @param oCount int. The number of fields of O in the segment.
+     * @return int. Positive if the segment is open for X, negative if it is open for O, 0 if both or none have fields in it.
+     */
+    static int lineValue(int xCount, int oCount){
+        if (xCount > 0 && oCount == 0){
+            return 1 << (2 * (xCount - 1));
+        } else if (oCount > 0 && xCount == 0){
+            return -(1 << (2 * (oCount - 1)));
+        }
+        return 0;
+    };
+    /**
+     * @brief Function to count the fields of both players in every segment of the board. Called once per search, during the search the counts are 
+     * updated by play and undo.
+     * @param currentBoard const Board&. The current game board.
+     * @return void
+     */
+    void countLines(const Board& currentBoard){
+        openLines = 0;
+        for (size_t i = 0; i < lines.size(); i++){
+            xInLine[i] = int((currentBoard.x & lines[i]).count());
+            oInLine[i] = int((currentBoard.o & lines[i]).count());
+            openLines += lineValue(xInLine[i], oInLine[i]);
+        }
+    };
+    /**
+     * @brief Function to make a move in the search and update the segment counts of the lines through the field.
+     * @param currentBoard Board&. The current game board.
+     * @param cell int. The field.
+     * @param c char. The player.
+     * @return void
+     */
+    void play(Board& currentBoard, int cell, char c){
+        currentBoard.insert(cell, c);
+        std::vector<int>& inLine = (c == 'X') ? xInLine : oInLine;
+        for (int line : linesThrough[cell]){
+            openLines -= lineValue(xInLine[line], oInLine[line]);
+            inLine[line]++;
+            openLines += lineValue(xInLine[line], oInLine[line]);
+        }
+    };
+    /**
+     * @brief Function to take back a move made with play.
+     * @param currentBoard Board&. The current game board.
+     * @param cell int. The field.
+     * @param c char. The player who made the move.
+     * @return void
+     */
+    void undo(Board& currentBoard, int cell, char c){
+        currentBoard.refree(cell);
+        std::vector<int>& inLine = (c == 'X') ? xInLine : oInLine;
+        for (int line : linesThrough[cell]){
+            openLines -= lineValue(xInLine[line], oInLine[line]);
+            inLine[line]--;
+            openLines += lineValue(xInLine[line], oInLine[line]);
+        }
+    };
+    /**
+     * @brief Function to score a position without searching further. Every segment of K fields that only one player has fields in is still open for 
+     * that player and is worth more the more of its fields are taken (4 times as much per field). The sum is kept up to date by play and undo.
+     * @param currentBoard const Board&. The current game board.
+     * @return int. The open lines of the player to move minus the open lines of the other player, limited to +-maxEvaluation so it stays below a win.
+     */
+    int evaluate(const Board& currentBoard) const {
+        int score = std::max(-maxEvaluation, std::min(maxEvaluation, openLines));
+        return (currentBoard.toMove() == 'X') ? score : -score;
+    };
+    /**
+     * @brief Function to check if the budget is used up. During the search the clock is only read every 1024 nodes. With several threads only the 
+     * first one reads the clock and tells the others to stop, the node budget counts the nodes of all threads.
+     * @param readClock bool. True to always read the clock.
+     * @return bool. True if the search has to stop.
+     */
+    bool outOfBudget(bool readClock = false){
+        if (pool){
+            if (nodes >= reportedNodes + 1024 || readClock){
+                pool->nodes.fetch_add(nodes - reportedNodes, std::memory_order_relaxed);
+                reportedNodes = nodes;
+            }
+            if (id != 0){
+                return halted();
+            }
+        }
+        uint64_t allNodes = pool ? pool->nodes.load(std::memory_order_relaxed) : nodes;
+        if (limits.nodes > 0 && allNodes >= limits.nodes){
+            stopped = true;
+        }
+        if ((limits.seconds > 0 || token) && (readClock || nodes >= nextClockCheck)){
+            nextClockCheck = nodes + 1024;
+            if ((limits.seconds > 0 && std::chrono::steady_clock::now() >= deadline) || (token && token->isCancelled())){
+                stopped = true;
+            }
+        }
+        if (stopped && pool){
+            pool->stop = true;
+        }
+        return halted();
+    };
+    /**
+     * @brief Function to check if the current search has to be given up, either because the budget is used up or because another thread found a 
+     * cutoff at one of the split points this thread is working under.
+     * @return bool. True if the result of the search will not be used.
+     */
+    bool halted() const {
+        if (stopped || (pool && pool->stop.load(std::memory_order_relaxed))){
+            return true;
+        }
+        for (const SplitPoint<Board>* split = currentSplit; split; split = split->parent){
+            if (split->cutoff.load(std::memory_order_relaxed)){
+                return true;
+            }
+        }
+        return false;
+    };
+    /**
+     * @brief Function to get the fields that are worth trying. On large boards (more than 2K rows) only fields at most 2 rows and columns away from a 
+     * taken field are tried, since a move far away from all others can not take part in a line soon. On the empty board this is only the centre.
+     * @param currentBoard const Board&. The current game board.
+     * @return std::bitset. The fields to try.
+     */
+    std::bitset<N * N> candidateMoves(const Board& currentBoard) const {
+        std::bitset<N * N> free = currentBoard.freeCells();
+        if (!localMoves){
+            return free;
+        }
+        std::bitset<N * N> near = currentBoard.x | currentBoard.o;
+        if (near.none()){
+            std::bitset<N * N> centreOnly;
+            centreOnly.set((N / 2) * N + N / 2);
+            return centreOnly;
+        }
+        for (int step = 0; step < 2; step++){
+            near |= ((near << 1) & notFirstColumn) | ((near >> 1) & notLastColumn);
+            near |= (near << N) | (near >> N);
+        }
+        return free & near;
+    };
+    /**
+     * @brief Function to sort the fields from candidateMoves in the order the search should try them.
+     * @param currentBoard const Board&. The current game board.
+     * @param ply int. The number of moves made since the start of the search, used for the killer moves.
+     * @param first int. Field that is always tried first, e.g. the move of the principal variation. -1 if there is none.
+     * @param second int. Field that is tried second, e.g. the best move from the table. -1 if there is none.
+     * @param moves int*. Array of at least N*N fields which is filled with the fields.
+     * @return int. The number of fields.
+     */
+    int orderMoves(const Board& currentBoard, int ply, int first, int second, int* moves){
+        uint64_t keys[cells];
+        int side = (currentBoard.toMove() == 'X') ? 0 : 1;
+        int count = 0;
+        std::bitset<cells> free = candidateMoves(currentBoard);
+        for (size_t cell = free._Find_first(); cell < size_t(cells); cell = free._Find_next(cell)){
+            uint64_t score = uint64_t(centre[cell]) + (uint64_t(history[side][cell]) << 8);
+            if (int(cell) == killers[ply]){
+                score = uint64_t(1) << 40;
+            }
+            if (int(cell) == second){
+                score = uint64_t(1) << 41;
+            }
+            if (int(cell) == first){
+                score = uint64_t(1) << 42;
+            }
+            keys[count++] = (score << 16) | (0xFFFF - cell);
+        }
+        std::sort(keys, keys + count, [](uint64_t a, uint64_t b){ return a > b; });
+        for (int i = 0; i < count; i++){
+            moves[i] = int(0xFFFF - (keys[i] & 0xFFFF));
+        }
+        return count;
+    };
+    /**
+     * @brief Minimax with alpha-beta pruning from the point of view of the player to move.
+     * @param currentBoard Board&. The current game board.
+     * @param ply int. The number of moves made since the start of the search.
+     * @param depth int. The number of moves left to look ahead. At 0 the position is scored by evaluate.
+     * @param alpha int. The score the player to move is already guaranteed.
+     * @param beta int. The score the other player is already guaranteed.
+     * @param onPV bool. True if all moves so far were the principal variation of the last iteration.
+     * @return int. The score of the position if it lies between alpha and beta, otherwise a bound on it. Meaningless if the budget ran out.
+     */
+    int negamax(Board& currentBoard, int ply, int depth, int alpha, int beta, bool onPV){
+        nodes++;
+        SEARCH_STAT(stats.maxDepth = std::max(stats.maxDepth, ply);)
+        if (currentBoard.winner != ' '){
+            SEARCH_STAT(stats.leaves++;)
+            return -(winScore + cells - currentBoard.count);
+        }
+        if (currentBoard.isDraw()){
+            SEARCH_STAT(stats.leaves++;)
+            return 0;
+        }
+        if (depth == 0){
+            SEARCH_STAT(stats.leaves++;)
+            return evaluate(currentBoard);
+        }
+        if (outOfBudget()){
+            return 0;
+        }
+        uint64_t key = currentBoard.hash;
+        int stored;
+        if (table->probe(key, alpha, beta, stored, depth)){
+            SEARCH_STAT(stats.tableHits++;)
+            return stored;
+        }
+        int moves[cells];
+        int first = (onPV && ply < int(pv.size())) ? pv[ply] : -1;
+        int count = orderMoves(currentBoard, ply, first, table->bestMove(key), moves);
+        SEARCH_STAT(stats.expanded++;)
+        char toMove = currentBoard.toMove();
+        int best = -(2 * winScore);
+        int bestCell = -1;
+        for (int i = 0; i < count; i++){
+            int cell = moves[i];
+            if (i == 1 && pool && depth >= pool->splitDepth){
+                int bestRank = 0;
+                splitSearch(currentBoard, ply, depth, alpha, beta, moves, count, 1, false, best, bestCell, bestRank);
+                if (halted()){
+                    return 0;
+                }
+                break;
+            }
+            SEARCH_STAT(stats.children++;)
+            play(currentBoard, cell, toMove);
+            int score = -negamax(currentBoard, ply+1, depth-1, -beta, -std::max(alpha, best), onPV && cell == first);
+            undo(currentBoard, cell, toMove);
+            if (halted()){
+                return 0;
+            }
+            if (score > best){
+                best = score;
+                bestCell = cell;
+            }
+            if (best >= beta){
+                break;
+            }
+        }
+        if (best >= beta){
+            SEARCH_STAT(stats.cutoffs++;)
+            killers[ply] = bestCell;
+            history[toMove == 'X' ? 0 : 1][bestCell] += uint32_t(depth * depth);
+        }
+        TranspositionTable::Bound bound = TranspositionTable::Exact;
+        if (best <= alpha){
+            bound = TranspositionTable::Upper;
+        } else if (best >= beta){
+            bound = TranspositionTable::Lower;
+        }
+        table->store(key, best, bound, bestCell, depth);
+        return best;
+    };
+    /**
+     * @brief Function to search the moves of a node on all threads of the pool (Young Brothers Wait). The first move (the eldest brother) has to be 
+     * searched before, so there is a good alpha. The remaining moves are pushed as tasks to the queue of this thread, where idle threads steal them. 
+     * While waiting for the tasks to finish, this thread works on tasks itself.
+     * @param currentBoard Board&. The board of the node.
+     * @param ply int. The number of moves made since the start of the search.
+     * @param depth int. The number of moves left to look ahead.
+     * @param alpha int. The lower end of the search window.
+     * @param beta int. The upper end of the search window.
+     * @param moves const int*. The sorted moves of the node.
+     * @param count int. The number of moves.
+     * @param from int. The first move that is not searched yet.
+     * @param rankByCell bool. True if ties between equal scores are broken by the lowest field (root), false if by the earliest move in the order.
+     * @param best int&. The best score so far, updated.
+     * @param bestCell int&. The best field so far, updated.
+     * @param bestRank int&. The rank of the best field so far, updated.
+     * @return void
+     */
+    void splitSearch(Board& currentBoard, int ply, int depth, int alpha, int beta, const int* moves, int count, int from, bool rankByCell, int& best, 
+        int& bestCell, int& bestRank){
+        SplitPoint<Board> split(currentBoard, currentSplit, ply, depth, alpha, beta, best, bestCell, bestRank);
+        split.pending = count - from;
+        for (int i = count - 1; i >= from; i--){
+            SearchTask<Board> task;
+            task.split = &split;
+            task.cell = moves[i];
+            task.rank = rankByCell ? moves[i] : i;
+            pool->pushTask(id, task);
+        }
+        while (split.pending.load() > 0){
+            SearchTask<Board> task;
+            if (pool->popTask(id, task) || pool->stealTask(id, task)){
+                runTask(task);
+                countLines(currentBoard);
+            } else {
+                if (id == 0){
+                    outOfBudget(true);
+                }
+                std::this_thread::yield();
+            }
+        }
+        best = split.best;
+        bestCell = split.bestCell;
+        bestRank = split.bestRank;
+    };
+    /**
+     * @brief Function to search one move of a split point. The move is searched on a copy of the board of the split point, with the best score of 
+     * the split point so far as alpha. Moves with a lower rank than the current best move also win on an equal score, so for those alpha is one lower.
+     * @param task const SearchTask<Board>&. The split point and the move.
+     * @return void
+     */
+    void runTask(const SearchTask<Board>& task){
+        SplitPoint<Board>& split = *task.split;
+        SplitPoint<Board>* saved = currentSplit;
+        currentSplit = &split;
+        if (!halted()){
+            int alpha;
+            {
+                std::lock_guard<std::mutex> lock(split.mutex);
+                alpha = std::max(split.alpha, (task.rank < split.bestRank) ? split.best - 1 : split.best);
+            }
+            if (alpha < split.beta){
+                Board board = split.board;
+                countLines(board);
+                SEARCH_STAT(stats.children++;)
+                play(board, task.cell, board.toMove());
+                int score = -negamax(board, split.ply+1, split.depth-1, -split.beta, -alpha, false);
+                if (!halted()){
+                    std::lock_guard<std::mutex> lock(split.mutex);
+                    if (score > split.best || (score == split.best && task.rank < split.bestRank)){
+                        split.best = score;
+                        split.bestCell = task.cell;
+                        split.bestRank = task.rank;
+                    }
+                    if (split.best >= split.beta){
+                        split.cutoff = true;
+                    }
+                }
+            }
+        }
+        currentSplit = saved;
+        split.pending.fetch_sub(1);
+    };
+    /**
+     * @brief Function to read the principal variation of the last iteration from the transposition table.
+     * @param currentBoard Board&. The current game board. It is the same again when the function returns.
+     * @param depth int. The maximum number of moves.
+     * @return void
+     */
+    void collectPV(Board& currentBoard, int depth){
+        pv.clear();
+        while (int(pv.size()) < depth && currentBoard.winner == ' ' && !currentBoard.isDraw()){
+            int cell = table->bestMove(currentBoard.hash);
+            if (cell < 0 || !currentBoard.isFree(cell)){
+                break;
+            }
+            pv.push_back(cell);
+            currentBoard.insert(cell, currentBoard.toMove());
+        }
+        for (int i = int(pv.size()) - 1; i >= 0; i--){
+            currentBoard.refree(pv[i]);
+        }
+    };
+    /**
+     * @brief Function to search all moves of the root position to a fixed depth.
+     * @param currentBoard Board&. The current game board.
+     * @param depth int. The number of moves to look ahead.
+     * @param bestCell int&. Set to the best field.
+     * @return int. The score of the best move.
+     * If several moves have the best score, the lowest field is chosen. Moves on a lower field than the current best move are searched with alpha one
+     * lower, so an equal score is found. This makes the result independent of the order the moves were searched in, so the parallel search chooses 
+     * the same move as the search on one thread whenever the scores are the same.
+     */
+    int searchRoot(Board& currentBoard, int depth, int& bestCell){
+        int moves[cells];
+        int count = orderMoves(currentBoard, 0, pv.empty() ? -1 : pv[0], table->bestMove(currentBoard.hash), moves);
+        SEARCH_STAT(stats.expanded++;)
+        char toMove = currentBoard.toMove();
+        int bestVal = -(2 * winScore);
+        bestCell = -1;
+        for (int i = 0; i < count && !halted(); i++){
+            if (i == 1 && pool){
+                int bestRank = bestCell;
+                splitSearch(currentBoard, 0, depth, -(2 * winScore), 2 * winScore, moves, count, 1, true, bestVal, bestCell, bestRank);
+                break;
+            }
+            int alpha = (bestCell >= 0 && moves[i] < bestCell) ? bestVal - 1 : bestVal;
+            SEARCH_STAT(stats.children++;)
+            play(currentBoard, moves[i], toMove);
+            int moveVal = -negamax(currentBoard, 1, depth-1, -(2 * winScore), -alpha, !pv.empty() && moves[i] == pv[0]);
+            undo(currentBoard, moves[i], toMove);
+            if (!halted() && (moveVal > bestVal || (moveVal == bestVal && moves[i] < bestCell))){
+                bestVal = moveVal;
+                bestCell = moves[i];
+            }
+        }
+        if (!halted()){
+            table->store(currentBoard.hash, bestVal, TranspositionTable::Exact, bestCell, depth);
+        }
+        return bestVal;
+    };
+    /**
+     * @brief Function to find the best move for the player to move with iterative deepening.
+     * @param currentBoard Board&. The current game board. It is the same again when the function returns.
+     * @param plimits SearchLimits. The budget for this move, unlimited by default. The first iteration always finishes unless the token
+     * stops it, in which case the free field closest to the centre is played, so there always is a move.
+     * @return int. The best field (row*N + column), -1 if the game is already over.
+     * After every finished iteration the principal variation is read from the table and searched first in the next iteration. The search stops early 
+     * when it looked ahead until the end of the game, since deeper iterations can not change the result. Without a time or node budget or a token the 
+     * position is searched to the maximum depth right away. The statistics of the search are in stats afterwards.
+     */
+    int findBestMove(Board& currentBoard, const SearchLimits& plimits = SearchLimits()){
+        stats = SearchStats();
+        SearchTimer timer(stats);
+        nodes = 0;
+        reportedNodes = 0;
+        nextClockCheck = 0;
+        completedDepth = 0;
+        stopped = false;
+        currentSplit = nullptr;
+        limits = SearchLimits();
+        token = plimits.token;
+        pv.clear();
+        std::fill(killers, killers + cells + 1, -1);
+        for (int side = 0; side < 2; side++){
+            for (int cell = 0; cell < cells; cell++){
+                history[side][cell] >>= 1;
+            }
+        }
+        if (currentBoard.winner != ' ' || currentBoard.isDraw()){
+            return -1;
+        }
+        if constexpr (Tablebase<N, K>::supported){
+            int cell;
+            uint8_t value;
+            if (tablebase && tablebase->lookup(currentBoard, cell, value)){
+                int left = cells - currentBoard.count - Tablebase<N, K>::distance(value);
+                typename Tablebase<N, K>::Result result = Tablebase<N, K>::result(value);
+                lastScore = (result == Tablebase<N, K>::Win) ? winScore + left : (result == Tablebase<N, K>::Loss) ? -(winScore + left) : 0;
+                completedDepth = cells - currentBoard.count;
+                return cell;
+            }
+        }
+        countLines(currentBoard);
+        int remaining = cells - currentBoard.count;
+        int maxDepth = (plimits.depth > 0) ? std::min(plimits.depth, remaining) : remaining;
+        deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(plimits.seconds));
+        int bestCell = -1;
+        int firstDepth = (plimits.seconds > 0 || plimits.nodes > 0 || plimits.token) ? 1 : maxDepth;
+        for (int depth = firstDepth; depth <= maxDepth; depth++){
+            int cell;
+            int score = searchRoot(currentBoard, depth, cell);
+            if (halted()){
+                break;
+            }
+            bestCell = cell;
+            lastScore = score;
+            completedDepth = depth;
+            collectPV(currentBoard, depth);
+            limits = plimits;
+            if (outOfBudget(true)){
+                break;
+            }
+        }
+        if (bestCell < 0){
+            // The token stopped the first iteration, so the move is only a guess: the free field closest to the centre.
+            for (int cell = 0; cell < cells; cell++){
+                if (currentBoard.isFree(cell) && (bestCell < 0 || centre[cell] > centre[bestCell])){
+                    bestCell = cell;
+                }
+            }
+        }
+        token = nullptr;
+        stats.nodes = nodes;
+        return bestCell;
+    };
+};
+/**
+ * @brief Class to search the best move on an MNKBoard with several threads.
+ * @class ParallelMNKSearch
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ *  Every thread has its own MNKSearch with its own copy of the board, all of them share one transposition table which works without locks. The 
+ * calling thread runs the iterative deepening. At the root and at every node with at least splitDepth moves left to look ahead, the first move is 
+ * searched alone and the other moves are put into the work queue of the thread (Young Brothers Wait). Idle threads steal moves from the front of 
+ * the other queues, a thread takes its own moves from the back. With one thread no other threads are started and the search is the same as MNKSearch.
+ */
+template<int N, int K>
+class ParallelMNKSearch {
+public:
+    using Board = MNKBoard<N, K>;
+    /**
+     * @brief Struct to represent the work queue of one thread.
+     */
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<SearchTask<Board>> tasks;
+    };
+    int splitDepth;
+    std::shared_ptr<TranspositionTable> table;
+    std::vector<std::unique_ptr<MNKSearch<N, K>>> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<bool> stop;
+    std::atomic<bool> searching;
+    std::atomic<uint64_t> nodes;
+    bool shutdown;
+    std::mutex stateMutex;
+    std::condition_variable wake;
+    /**
+     * @brief Constructor for the ParallelMNKSearch class. Starts the threads, which wait until there is a search.
+     * @param threadCount int. The number of threads including the calling thread. 0 uses one thread per core.
+     * @param tableSize size_t. The number of entries of the shared transposition table.
+     * @param psplitDepth int. The minimum number of moves left to look ahead for a node to be split between threads.
+     */
+    ParallelMNKSearch(int threadCount = 1, size_t tableSize = size_t(1) << 20, int psplitDepth = 3) : splitDepth(psplitDepth), 
+        table(std::make_shared<TranspositionTable>(tableSize)), stop(false), searching(false), nodes(0), shutdown(false) {
+        if (threadCount <= 0){
+            threadCount = std::max(1, int(std::thread::hardware_concurrency()));
+        }
+        for (int i = 0; i < threadCount; i++){
+            workers.push_back(std::make_unique<MNKSearch<N, K>>(table, threadCount > 1 ? this : nullptr, i));
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        for (int i = 1; i < threadCount; i++){
+            threads.emplace_back([this, i](){ helperLoop(i); });
+        }
+    };
+    ParallelMNKSearch(const ParallelMNKSearch&) = delete;
+    ParallelMNKSearch& operator=(const ParallelMNKSearch&) = delete;
+    /**
+     * @brief Destructor for the ParallelMNKSearch class. Stops and joins the threads.
+     */
+    ~ParallelMNKSearch(){
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            shutdown = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads){
+            thread.join();
+        }
+    };
+    /**
+     * @brief Getter for the number of threads.
+     * @return int. The number of threads including the calling thread.
+     */
+    int threadCount() const {
+        return int(workers.size());
+    };
+    /**
+     * @brief Function to put a task at the back of the queue of a thread.
+     * @param owner int. The thread.
+     * @param task const SearchTask<Board>&. The task.
+     * @return void
+     */
+    void pushTask(int owner, const SearchTask<Board>& task){
+        std::lock_guard<std::mutex> lock(queues[owner]->mutex);
+        queues[owner]->tasks.push_back(task);
+    };
+    /**
+     * @brief Function to take a task from the back of the own queue.
+     * @param owner int. The thread.
+     * @param task SearchTask<Board>&. Set to the task.
+     * @return bool. True if there was a task.
+     */
+    bool popTask(int owner, SearchTask<Board>& task){
+        std::lock_guard<std::mutex> lock(queues[owner]->mutex);
+        if (queues[owner]->tasks.empty()){
+            return false;
+        }
+        task = queues[owner]->tasks.back();
+        queues[owner]->tasks.pop_back();
+        return true;
+    };
+    /**
+     * @brief Function to steal a task from the front of the queue of another thread.
+     * @param thief int. The thread that is looking for work.
+     * @param task SearchTask<Board>&. Set to the task.
+     * @return bool. True if a task was found.
+     */
+    bool stealTask(int thief, SearchTask<Board>& task){
+        for (size_t offset = 1; offset < queues.size(); offset++){
+            WorkQueue& queue = *queues[(thief + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()){
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    };
+    /**
+     * @brief Function run by every thread except the calling one. Steals tasks while there is a search and sleeps otherwise.
+     * @param worker int. The number of the thread.
+     * @return void
+     */
+    void helperLoop(int worker){
+        while (true){
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                wake.wait(lock, [this](){ return shutdown || searching.load(); });
+                if (shutdown){
+                    return;
+                }
+            }
+            SearchTask<Board> task;
+            while (searching.load()){
+                if (stealTask(worker, task)){
+                    workers[worker]->runTask(task);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+    /**
+     * @brief Function to find the best move with all threads.
+     * @param currentBoard Board&. The current game board. It is the same again when the function returns.
+     * @param limits SearchLimits. The budget for this move.
+     * @return int. The best field (row*N + column), -1 if the game is already over.
+     */
+    int findBestMove(Board& currentBoard, const SearchLimits& limits = SearchLimits()){
+        stop = false;
+        nodes = 0;
+        for (auto& worker : workers){
+            worker->nodes = 0;
+            worker->reportedNodes = 0;
+            worker->stopped = false;
+            worker->stats = SearchStats();
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            searching = true;
+        }
+        wake.notify_all();
+        int cell = workers[0]->findBestMove(currentBoard, limits);
+        searching = false;
+        return cell;
+    };
+    /**
+     * @brief Getter for the number of nodes all threads searched in the last call of findBestMove.
+     * @return uint64_t. The sum of the nodes of all threads.
+     */
+    uint64_t totalNodes() const {
+        uint64_t total = 0;
+        for (const auto& worker : workers){
+            total += worker->nodes;
+        }
+        return total;
+    };
+    /**
+     * @brief Getter for the statistics of the last call of findBestMove, added up over all threads. The time is the wall time of the search.
+     * @return SearchStats. The statistics.
+     */
+    SearchStats stats() const {
+        SearchStats total = workers[0]->stats;
+        for (size_t i = 1; i < workers.size(); i++){
+            SearchStats helper = workers[i]->stats;
+            helper.nodes = workers[i]->nodes;
+            helper.seconds = 0;
+            total.merge(helper);
+        }
+        total.nodes = totalNodes();
+        return total;
+    };
+};
+/**
+ * @brief Class to represent a Tic Tac Toe game board. The game board is a size x size grid with each field being either free or occupied by a player.
+ * @class GameBoard
+ *  The grid is an array of Fields which are either free or occupied by a player. Since a value can only be X or O, a boolean is used to represent the value. 
+ * True represents X and False represents O. A boolean is also used to represent if the field is free or occupied. True represents free and False represents occupied.
+ * The board is 3x3 with 3 in a row by default, but any size and number in a row (m,n,k game) can be used. Since a player can only win with the field they
+ * just took, insert only checks the lines through that field and remembers the winner.
+ */
+class GameBoard {
+public:
+    /**
+     * @brief Struct to represent a field on the game board. A field can either be free or occupied by a player. A field can also have a value of X or O. represented by a boolean.
+     */
+    struct Field {
+    bool isFree;
+    bool isValueX;
+    /**
+     * @brief Constructor for the Field struct. Initializes the field as free and with is ValueX as false. This means that when checking for the winner i always 
+     * have to check if the field is free or not. If the field is not free, then i can check if the value is X or O. If I do not do this it will lead to a bug.
+     *  In hindsight, I should have just used a char to represent the value of the field. This would have made it easier.
+     */
+    Field() : isFree(true), isValueX(false) {};
+    /**
+     * @brief Getter for the isFree attribute of the field.
+     * @return bool. True if the field is free, false if the field is occupied.
+     */
+    bool getFree() { return isFree; };
+    /**
+     * @brief Getter for the isValueX attribute of the field.
+     * @return char. Returns 'X' if the field is occupied by X, 'O' if the field is occupied by O.
+     */
+    char getValue() {
+        if(isValueX){
+            return 'X';
+        } else {
+            return 'O';
+        }
+        };
+    /**
+     * @brief Setter for the isFree attribute of the field.
+     * @param free bool. 
+     */
+    void setFree(bool free) { isFree = free; };
+    /**
+     * @brief Setter for the isValueX attribute of the field.
+     * @param value bool. True if the field is shall be occupied by X, false if the field shall be occupied by O.
+     */
+    void setValue(bool value) { isValueX = value; };
+    };
+
+    /**
+     * @brief Struct to represent a move in the history of the board.
+     */
+    struct HistoryEntry {
+        int cell;
+        char c;
+    };
+
+    int size;
+    int winLength;
+    std::vector<Field> board;
+    char winner;
+    std::vector<HistoryEntry> history;
+    std::vector<HistoryEntry> undone;
+    int filled;
+    std::vector<int> lineStart;
+    std::vector<int> cellLines;
+    std::vector<uint8_t> lineCount[2];
+    int completed[2];
+    /**
+     * @brief Constructor for the GameBoard class. Initializes the game board as a size x size grid using the Field struct.
+     * @param psize int. The number of rows and columns.
+     * @param pwinLength int. The number of fields in a row needed to win.
+     * The history has room for every field, so making and taking back moves never allocates. Every winLength fields in a row, column or diagonal 
+     * are a line, the fields of line i are counted for X in lineCount[0][i] and for O in lineCount[1][i]. The lines through field f are 
+     * cellLines[lineStart[f]] to cellLines[lineStart[f+1] - 1], completed counts the full lines of each player.
+     */
+    GameBoard(int psize = 3, int pwinLength = 3);
+    /**
+     * @brief Function to get a field of the game board.
+     * @param row int. The row of the field.
+     * @param column int. The column of the field.
+     * @return Field&. The field.
+     */
+    Field& at(int row, int column){
+        return board[row * size + column];
+    };
+    /**
+     * @brief Function to write a row of the game board into a buffer. Uses ASCII art to represent the game board.
+     * @param row int. The row to be written.
+     * @param out char*. Where the row is written.
+     * @return char*. The end of the row in the buffer.
+     * Row numbers are padded to the width of the largest one.
+     */
+    char* renderRow(int row, char* out) const;
+    /**
+     * @brief Function to write a seperator line between the rows of the game board into a buffer. Uses 4 dashes per column and one more, 13 dashes 
+     * for 3x3 to exactly match the provided screenshot.
+     * @param out char*. Where the line is written.
+     * @return char*. The end of the line in the buffer.
+     */
+    char* renderSeperator(char* out) const;
+    /**
+     * @brief Function to get the size of the buffer render needs.
+     * @return size_t. An upper bound on the number of characters of the board.
+     */
+    size_t frameBytes() const {
+        return size_t(2*size+2) * size_t(4*size+16);
+    };
+    /**
+     * @brief Function to write the whole game board into a buffer. First the column numbers and a seperator line, then each row and a seperator 
+     * line after each row.
+     * @param out char*. Where the board is written, at least frameBytes() characters.
+     * @return size_t. The number of characters written.
+     */
+    size_t render(char* out) const;
+    /**
+     * @brief Function to print the game board. Uses ASCII art to represent the game board.
+     * @return void
+     * The board is formatted in a buffer on the stack and written with one call, without flushing. Boards larger than the buffer (more than 20x20) 
+     * use a buffer on the heap.
+     */
+    void printBoard() const;
+    /**
+     * @brief Destructor for the GameBoard class.
+     */
+    ~GameBoard(){};
+    /**
+     * @brief Function to update the counters of the lines through a field.
+     * @param cell int. The field (row*size + column).
+     * @param c char. The player of the field, 'X' or 'O'.
+     * @param delta int. 1 if the field was taken, -1 if it was freed.
+     * @return void
+     */
+    void countLines(int cell, char c, int delta);
+    /**
+     * @brief Function to insert a value into a field on the game board.
+     * @param row int. The row of the field to be inserted into.
+     * @param column int. The column of the field to be inserted into.
+     * @param c char. The value to be inserted into the field. 'X' for X, 'O' for O.
+     * @return void
+     * If the field is free, the value is inserted into the field. If the field is not free, the value is not inserted.
+     * The counters of the lines through the field are updated, if one of them is full the player is remembered as the winner. The move is pushed on the history and the moves that were taken back 
+     * with undo can not be redone anymore.
+     */
+    void insert(int row, int column, char c);
+    /**
+     * @brief Function to put a value on a free field and push the move on the history.
+     * @param cell int. The field (row*size + column).
+     * @param c char. The value, 'X' or 'O'.
+     * @return bool. True if the field was free and the value valid.
+     */
+    bool place(int cell, char c);
+    /**
+     * @brief Function to set the winner from the full lines after a field was freed.
+     * @return void
+     * The winner stays if it still has a full line, otherwise the player with a full line wins, or nobody. insert accepts moves after a win, so 
+     * the other player may own a full line as well.
+     */
+    void updateWinner();
+    /**
+     * @brief Function to take back the last move.
+     * @return bool. False if there is no move to take back.
+     * The field is free again and the winner is set from the full lines that are left.
+     */
+    bool undo();
+    /**
+     * @brief Function to play the last move that was taken back again.
+     * @return bool. False if there is no move to redo.
+     */
+    bool redo();
+    /**
+     * @brief Function to remove a value from a field on the game board.
+     * @param row int. The row of the field to be removed from.
+     * @param column int. The column of the field to be removed from.
+     * @return void
+     * Sets the field as free. Used for the minimax algorithm. If the winner has no full line left afterwards, the other player wins if it has one, 
+     * otherwise there is no winner anymore. The move is removed from the history, the last move is taken back with undo.
+     * A field that has no move in the history is left as it is.
+     */
+    void refree(int row, int column);
+    /**
+     * @brief Function to check if a field is free or occupied.
+     * @param row int. The row of the field to be checked.
+     * @param column int. The column of the field to be checked.
+     * @return bool. True if the field is free, false if the field is occupied.
+     */
+    bool isFree(int row, int column){
+        if (at(row, column).getFree()){
+            return true;
+        } else {
+            return false;
+        }
+    };
+    /**
+     * @brief Function to check if a player has won the game.
+     * @param c char. The player to be checked. 'X' for X, 'O' for O.
+     * @return bool. True if the player has won, false if the player has not won.
+     * The winner is found by insert from the counters of the lines through the new field.
+     */
+    bool isWinner(char c){
+        return winner == c;
+    };
+    /**
+     * @brief Function to check if the game is a draw.
+     * @return bool. True if the game is a draw, false if the game is not a draw.
+     * The game is a draw when all fields are occupied, the occupied fields are counted by insert and refree.
+     */
+    bool isDraw(){
+        return filled == size * size;
+    };
+    /**
+     * @brief Function to convert the game board into the board type used by a search, e.g. BitBoard or MNKBoard.
+     * @return Board. The same position, fields are numbered row*size + column.
+     */
+    template<class Board>
+    Board toBoard() const {
+        Board bits;
+        for (int i = 0; i < size * size; i++){
+            if (!board[i].isFree){
+                bits.insert(i, board[i].isValueX ? 'X' : 'O');
+            }
+        }
+        return bits;
+    };
+    /**
+     * @brief Function to convert the game board into a BitBoard for the minimax search. Only valid for the 3x3 board.
+     * @return BitBoard. The same position with one bit per occupied field.
+     */
+    BitBoard toBitBoard() const {
+        return toBoard<BitBoard>();
+    };
+
+};
+/**
+ * @brief Struct to represent a finished game: the fields in the order they were played (X first) and the result.
+ */
+struct GameRecord {
+    const uint8_t* moves;
+    uint16_t length;
+    uint8_t size;
+    char result;
+};
+/**
+ * @brief Class to keep many game records without one allocation per game.
+ * @class GameRecordArena
+ *  The moves of all games are copied into large blocks one after another (bump allocation), a new block is only needed every blockSize bytes. The 
+ * records themselves are kept in blocks of the same size, so adding a game never moves the earlier records and clear keeps all blocks for the next 
+ * games. The records point into the blocks, so they stay valid until clear or the arena is destroyed. Every thread of a batch run uses its own arena.
+ */
+class GameRecordArena {
+public:
+    static constexpr size_t defaultBlockSize = size_t(1) << 16;
+    size_t blockSize;
+    size_t recordsPerBlock;
+    std::vector<std::unique_ptr<uint8_t[]>> blocks;
+    std::vector<std::unique_ptr<GameRecord[]>> recordBlocks;
+    size_t used;
+    size_t currentBlock;
+    size_t count;
+    /**
+     * @brief Constructor for the GameRecordArena class. No memory is taken before the first game.
+     * @param pblockSize size_t. The size of a block in bytes, also the most moves a game can have.
+     */
+    GameRecordArena(size_t pblockSize = defaultBlockSize) : blockSize(pblockSize), recordsPerBlock(std::max<size_t>(1, pblockSize / sizeof(GameRecord))), 
+        used(0), currentBlock(0), count(0) {};
+    GameRecordArena(GameRecordArena&&) = default;
+    GameRecordArena& operator=(GameRecordArena&&) = default;
+    /**
+     * @brief Function to get memory for the moves of a game. Blocks that were freed by clear are used again.
+     * @param bytes size_t. The number of bytes, at most blockSize.
+     * @return uint8_t*. The memory.
+     */
+    uint8_t* allocate(size_t bytes);
+    /**
+     * @brief Function to get the next free record, a new block of records is only needed every recordsPerBlock games.
+     * @return GameRecord&. The record, counted as a game.
+     */
+    GameRecord& nextRecord();
+    /**
+     * @brief Function to add a game.
+     * @param moves const uint8_t*. The fields in the order they were played.
+     * @param length size_t. The number of moves, at most blockSize and 65535.
+     * @param size int. The number of rows and columns of the board.
+     * @param result char. 'X' or 'O' for the winner, 'D' for a draw.
+     * @return const GameRecord*. The record, valid until clear. nullptr if the game is too long, then nothing is added.
+     */
+    const GameRecord* add(const uint8_t* moves, size_t length, int size, char result);
+    /**
+     * @brief Function to add the game that was played on a board. The moves are copied from the history straight into the block.
+     * @param game const GameBoard&. The board, its history has the moves.
+     * @return const GameRecord*. The record, nullptr if the game is too long or the fields of the board do not fit into a byte.
+     */
+    const GameRecord* add(const GameBoard& game);
+    /**
+     * @brief Function to remove all games. The blocks are kept and used again.
+     * @return void
+     */
+    void clear(){
+        count = 0;
+        currentBlock = 0;
+        used = 0;
+    };
+    /**
+     * @brief Getter for a game.
+     * @param index size_t. The number of the game in the order it was added.
+     * @return const GameRecord&. The record.
+     */
+    const GameRecord& operator[](size_t index) const {
+        return recordBlocks[index / recordsPerBlock][index % recordsPerBlock];
+    };
+    /**
+     * @brief Getter for the number of games.
+     * @return size_t. The number of games.
+     */
+    size_t size() const {
+        return count;
+    };
+    /**
+     * @brief Getter for the memory taken by the blocks.
+     * @return size_t. The number of bytes.
+     */
+    size_t bytes() const {
+        return blocks.size() * blockSize + recordBlocks.size() * recordsPerBlock * sizeof(GameRecord);
+    };
+};
+/**
+ * @brief Class with the format of the binary game log and its compression.
+ * @class GameLog
+ *  The file starts with a FileHeader and is followed by blocks. Every block has a BlockHeader and the games of the block, compressed if that makes 
+ * the block smaller. A game is one byte with the number of moves (low 4 bits) and the result (high 4 bits, 1 X, 2 O, 3 draw), followed by the moves 
+ * as 4 bit fields, two per byte. After the last block the index (one IndexEntry per block) and the Trailer are written, so a reader can find the block 
+ * of any game without reading the blocks before it. Only 3x3 games fit into 4 bit fields.
+ *  The compression is a small LZ77 variant: a token byte with the number of literals (high 4 bits) and the match length minus 4 (low 4 bits), longer 
+ * lengths continue in the following bytes (255 means another byte follows), then the literals and a 16 bit offset back to the match.
+ */
+class GameLog {
+public:
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+    struct BlockHeader {
+        uint32_t games;
+        uint32_t rawBytes;
+        uint32_t storedBytes;
+        uint32_t flags;
+    };
+    struct IndexEntry {
+        uint64_t offset;
+        uint64_t firstGame;
+    };
+    struct Trailer {
+        uint64_t indexOffset;
+        uint64_t games;
+        uint32_t blocks;
+        char magic[4];
+    };
+    static constexpr char magic[4] = {'T', 'T', 'T', 'L'};
+    static constexpr char trailerMagic[4] = {'T', 'T', 'T', 'I'};
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t compressed = 1;
+    static constexpr size_t blockBytes = size_t(1) << 16;
+    /**
+     * @brief Function to write a length that did not fit into its 4 bits of the token.
+     * @param length size_t. The rest of the length.
+     * @param out std::vector<uint8_t>&. The output.
+     * @return void
+     */
+    static void writeLength(size_t length, std::vector<uint8_t>& out);
+    /**
+     * @brief Function to compress a block.
+     * @param in const uint8_t*. The data.
+     * @param size size_t. The number of bytes.
+     * @param out std::vector<uint8_t>&. Set to the compressed data.
+     * @return void
+     */
+    static void compress(const uint8_t* in, size_t size, std::vector<uint8_t>& out);
+    /**
+     * @brief Function to read a length that did not fit into its 4 bits of the token.
+     * @param in const uint8_t*&. The position in the compressed data, moved past the length.
+     * @param end const uint8_t*. The end of the compressed data.
+     * @param length size_t&. The length, increased.
+     * @return bool. False if the data ended.
+     */
+    static bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length);
+    /**
+     * @brief Function to decompress a block.
+     * @param in const uint8_t*. The compressed data.
+     * @param size size_t. The number of compressed bytes.
+     * @param out uint8_t*. Set to the data.
+     * @param rawSize size_t. The number of bytes of the data.
+     * @return bool. False if the compressed data is corrupt.
+     */
+    static bool decompress(const uint8_t* in, size_t size, uint8_t* out, size_t rawSize);
+    /**
+     * @brief Function to get the number of bytes of an encoded game from its first byte.
+     * @param first uint8_t. The first byte of the game.
+     * @return size_t. The number of bytes.
+     */
+    static size_t gameBytes(uint8_t first){
+        return 1 + ((first & 15) + 1) / 2;
+    };
+};
+/**
+ * @brief Class to write a game log. Games are collected in a block in memory, which is written when it is full, so the file is written in large 
+ * pieces. The index is written by close.
+ * @class GameLogWriter
+ */
+class GameLogWriter {
+public:
+    std::ofstream out;
+    bool compress;
+    std::vector<uint8_t> block;
+    std::vector<uint8_t> packed;
+    uint32_t blockGames;
+    uint64_t games;
+    uint64_t offset;
+    std::vector<GameLog::IndexEntry> index;
+    /**
+     * @brief Constructor for the GameLogWriter class. Creates the file, an existing file is replaced.
+     * @param path const char*. The path of the file.
+     * @param pcompress bool. True to compress the blocks.
+     */
+    GameLogWriter(const char* path, bool pcompress = true);
+    /**
+     * @brief Destructor for the GameLogWriter class. Closes the log if close was not called.
+     */
+    ~GameLogWriter(){
+        close();
+    };
+    /**
+     * @brief Function to check if the file could be written so far.
+     * @return bool. True if there was no error.
+     */
+    bool good() const {
+        return bool(out);
+    };
+    /**
+     * @brief Function to add a game. Games on boards other than 3x3 are skipped.
+     * @param record const GameRecord&. The game.
+     * @return void
+     */
+    void add(const GameRecord& record);
+    /**
+     * @brief Function to add the game that was played on a board.
+     * @param game const GameBoard&. The board, its history has the moves.
+     * @return void
+     */
+    void add(const GameBoard& game);
+    /**
+     * @brief Function to add all games of an arena.
+     * @param arena const GameRecordArena&. The games.
+     * @return void
+     */
+    void add(const GameRecordArena& arena);
+    /**
+     * @brief Function to write the current block, compressed if that makes it smaller.
+     * @return void
+     */
+    void flushBlock();
+    /**
+     * @brief Function to write the last block, the index and the trailer and close the file. Nothing can be added afterwards.
+     * @return bool. True if the whole file was written.
+     */
+    bool close();
+};
+/**
+ * @brief Class to read a game log. The file is mapped into memory, so only the blocks that are read are loaded from the disk.
+ * @class GameLogReader
+ */
+class GameLogReader {
+public:
+    /**
+     * @brief Struct to represent the statistics of the games in a log.
+     */
+    struct Statistics {
+        uint64_t games;
+        uint64_t results[3];
+        uint64_t lengths[10];
+        uint64_t firstMoves[9];
+        uint64_t openings[81];
+    };
+    const uint8_t* data;
+    size_t size;
+    bool opened;
+    GameLog::Trailer trailer;
+    /**
+     * @brief Constructor for the GameLogReader class. Nothing is opened yet.
+     */
+    GameLogReader() : data(nullptr), size(0), opened(false), trailer() {};
+    GameLogReader(const GameLogReader&) = delete;
+    GameLogReader& operator=(const GameLogReader&) = delete;
+    /**
+     * @brief Destructor for the GameLogReader class. Unmaps the file.
+     */
+    ~GameLogReader(){
+        if (data){
+            munmap(const_cast<uint8_t*>(data), size);
+        }
+    };
+    /**
+     * @brief Function to read a header of the file. The blocks are not padded, so the headers are copied instead of read in place.
+     * @tparam T class. FileHeader, BlockHeader, IndexEntry or Trailer.
+     * @param offset size_t. The position of the header in the file, the caller checks that it is inside the file.
+     * @return T. The header.
+     */
+    template<class T>
+    T read(size_t offset) const {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        return value;
+    };
+    /**
+     * @brief Function to open a log. A log that is already open is unmapped first.
+     * @param path const char*. The path of the file.
+     * @return bool. False if the file can not be read or is not a complete game log.
+     */
+    bool open(const char* path);
+    /**
+     * @brief Getter for the number of games.
+     * @return uint64_t. The number of games in the log.
+     */
+    uint64_t games() const {
+        return opened ? trailer.games : 0;
+    };
+    /**
+     * @brief Getter for an entry of the index.
+     * @param block uint32_t. The block, less than trailer.blocks.
+     * @return GameLog::IndexEntry. The offset and the first game of the block.
+     */
+    GameLog::IndexEntry entry(uint32_t block) const {
+        return read<GameLog::IndexEntry>(trailer.indexOffset + block * sizeof(GameLog::IndexEntry));
+    };
+    /**
+     * @brief Function to get the games of a block, decompressed if needed.
+     * @param block uint32_t. The block.
+     * @param buffer std::vector<uint8_t>&. Holds the decompressed games.
+     * @param games const uint8_t*&. Set to the first game.
+     * @param header GameLog::BlockHeader&. Set to the header of the block.
+     * @return bool. False if the block is corrupt, the header is checked before the buffer is resized, so a block never takes more than 
+     * GameLog::blockBytes.
+     */
+    bool readBlock(uint32_t block, std::vector<uint8_t>& buffer, const uint8_t*& games, GameLog::BlockHeader& header) const;
+    /**
+     * @brief Function to unpack one game and check it.
+     * @param game const uint8_t*. The encoded game, the caller checks that all of its bytes are inside the block.
+     * @param moves uint8_t*. Set to the moves, room for 9.
+     * @param length int&. Set to the number of moves.
+     * @param result char&. Set to the result, 'X', 'O' or 'D'.
+     * @return bool. False if the game is corrupt: more than 9 moves, a field outside the board, a field played twice or an unknown result.
+     */
+    static bool unpack(const uint8_t* game, uint8_t* moves, int& length, char& result);
+    /**
+     * @brief Function to call a function for every game, block by block.
+     * @tparam Visitor class. Callable with (const uint8_t* moves, int length, char result), the moves are unpacked.
+     * @param visitor Visitor. The function.
+     * @return bool. False if a block or a game is corrupt, the games before it have been visited.
+     */
+    template<class Visitor>
+    bool forEachGame(Visitor visitor) const {
+        if (!opened){
+            return false;
+        }
+        std::vector<uint8_t> buffer;
+        for (uint32_t block = 0; block < trailer.blocks; block++){
+            const uint8_t* game;
+            GameLog::BlockHeader header;
+            if (!readBlock(block, buffer, game, header)){
+                return false;
+            }
+            const uint8_t* end = game + header.rawBytes;
+            for (uint32_t i = 0; i < header.games; i++){
+                uint8_t moves[9];
+                int length;
+                char result;
+                if (game >= end || game + GameLog::gameBytes(*game) > end || !unpack(game, moves, length, result)){
+                    return false;
+                }
+                visitor(moves, length, result);
+                game += GameLog::gameBytes(*game);
+            }
+        }
+        return true;
+    };
+    /**
+     * @brief Function to read one game without reading the blocks before it. The block is found in the index with a binary search.
+     * @param number uint64_t. The number of the game, 0 is the first game.
+     * @param moves std::vector<int>&. Set to the moves.
+     * @param result char&. Set to the result, 'X', 'O' or 'D'.
+     * @return bool. False if there is no such game or the block is corrupt.
+     */
+    bool game(uint64_t number, std::vector<int>& moves, char& result) const;
+    /**
+     * @brief Function to count the results, the game lengths and the openings of all games.
+     * @param statistics Statistics&. Set to the counts.
+     * @return bool. False if a block is corrupt.
+     */
+    bool statistics(Statistics& statistics) const;
+};
+/**
+ * @brief Abstract class to represent a player in the Tic Tac Toe game.
+ * @class Player
+ *  A player gets the board and its symbol and returns the field it wants to play, the Game loop inserts it. So every player can play X and O. The 
+ * players at the console are chosen from the menu at runtime, so chooseMove is virtual. The batch self-play uses agents (see Agent) without virtual calls.
+ */
+class Player {
+public:
+    Player(){};
+    virtual ~Player(){};
+    /**
+     * @brief Function to choose the field of the next move.
+     * @param currentBoard GameBoard&. The current game board. It is the same again when the function returns.
+     * @param c char. The symbol of the player, 'X' or 'O'.
+     * @return int. The field (row*size + column), it has to be free.
+     */
+    virtual int chooseMove(GameBoard& currentBoard, char c) = 0;
+    /**
+     * @brief Function called before the opponent chooses a move, so a computer player can search in the meantime (pondering). Does nothing by default.
+     * @param currentBoard const GameBoard&. The current game board, the opponent is to move.
+     * @param c char. The symbol of the player, 'X' or 'O'.
+     * @return void
+     */
+    virtual void ponder([[maybe_unused]] const GameBoard& currentBoard, [[maybe_unused]] char c){};
+    /**
+     * @brief Function called after the opponent chose a move, stops the search started by ponder. Does nothing by default.
+     * @return void
+     */
+    virtual void stopPondering(){};
+};
+/**
+ * @brief Struct to hold, for every set of free fields, the fields in order, so the k-th free field is one lookup.
+ */
+struct SelectTable {
+    int8_t cell[512][9];
+    /**
+     * @brief Constructor for the SelectTable struct. Fills the table at compile time.
+     */
+    constexpr SelectTable() : cell() {
+        for (int mask = 0; mask < 512; mask++){
+            int k = 0;
+            for (int c = 0; c < 9; c++){
+                cell[mask][c] = -1;
+            }
+            for (int c = 0; c < 9; c++){
+                if (mask & (1 << c)){
+                    cell[mask][k++] = int8_t(c);
+                }
+            }
+        }
+    };
+};
+static constexpr SelectTable selectTable{};
+/**
+ * @brief Class to generate random numbers for the computer players (xoshiro256**). It is much faster than std::mt19937 and has a small state, so 
+ * every player keeps its own generator for the whole game.
+ * @class FastRandom
+ */
+class FastRandom {
+public:
+    uint64_t state[4];
+    /**
+     * @brief Constructor for the FastRandom class.
+     * @param seed uint64_t. The seed.
+     */
+    FastRandom(uint64_t seed = 0){
+        reseed(seed);
+    };
+    /**
+     * @brief Function to start the generator again from a seed. The state is filled with splitmix64, so similar seeds give different numbers.
+     * @param seed uint64_t. The seed.
+     * @return void
+     */
+    void reseed(uint64_t seed){
+        for (int i = 0; i < 4; i++){
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            state[i] = z ^ (z >> 31);
+        }
+    };
+    /**
+     * @brief Function to get the next random number.
+     * @return uint64_t. 64 random bits.
+     */
+    uint64_t next(){
+        uint64_t result = rotate(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+        return result;
+    };
+    /**
+     * @brief Function to get a random number below n without a division (multiply and shift). The bias is below 2^-32 for the small n used here.
+     * @param n uint32_t. The number of possible values.
+     * @return uint32_t. A number from 0 to n-1.
+     */
+    uint32_t below(uint32_t n){
+        return uint32_t((uint64_t(uint32_t(next() >> 32)) * n) >> 32);
+    };
+    /**
+     * @brief Function to decide something with a given chance.
+     * @param probability double. The chance to return true.
+     * @return bool. True with the given chance.
+     */
+    bool chance(double probability){
+        return double(next() >> 11) * 0x1.0p-53 < probability;
+    };
+    /**
+     * @brief Function to pick a random field of a set of fields, every field has the same chance.
+     * @param cells uint16_t. The fields to choose from as a bitmask, must not be empty.
+     * @return int. The field.
+     */
+    int pick(uint16_t cells){
+        return selectTable.cell[cells][below(uint32_t(__builtin_popcount(cells)))];
+    };
+    /**
+     * @brief Function to pick a random field of a set of fields with a chance proportional to a weight per field.
+     * @param cells uint16_t. The fields to choose from as a bitmask, must not be empty.
+     * @param weights const uint32_t*. The weight of every field, at least one of the fields must have a weight above 0.
+     * @return int. The field.
+     */
+    int pickWeighted(uint16_t cells, const uint32_t* weights){
+        uint32_t sum = 0;
+        for (uint16_t free = cells; free; free &= free - 1){
+            sum += weights[__builtin_ctz(free)];
+        }
+        uint32_t r = below(sum);
+        for (uint16_t free = cells; ; free &= free - 1){
+            int cell = __builtin_ctz(free);
+            if (r < weights[cell]){
+                return cell;
+            }
+            r -= weights[cell];
+        }
+    };
+    /**
+     * @brief Function to get the generator of the current thread, which is seeded once from std::random_device. New players take their seed from it, 
+     * so the operating system is only asked for entropy once per thread.
+     * @return FastRandom&. The generator.
+     */
+    static FastRandom& local(){
+        thread_local FastRandom generator(uint64_t(std::random_device{}()) << 32 | std::random_device{}());
+        return generator;
+    };
+private:
+    static uint64_t rotate(uint64_t value, int bits){
+        return (value << bits) | (value >> (64 - bits));
+    };
+};
+/**
+ * @brief Base class of the agents, players that choose their moves on a BitBoard without any input or output (curiously recurring template pattern).
+ * @class Agent
+ * @tparam Derived class. The agent. It implements int chooseMove(BitBoard& currentBoard, char c), which returns a free field and leaves the board as 
+ * it was, and can hide newGame and getStats.
+ *  The batch self-play knows the types of its agents at compile time, so the calls are not virtual and can be inlined. AgentPlayer makes an agent 
+ * a Player for the console. Agents that search stop when token is cancelled and play the best move they have so far.
+ */
+template<class Derived>
+class Agent {
+public:
+    const CancellationToken* token;
+    /**
+     * @brief Constructor for the Agent class. Without a token.
+     */
+    Agent() : token(nullptr) {};
+    /**
+     * @brief Function called before every game, so agents that use random numbers play the same game again for the same seed.
+     * @param seed uint64_t. The seed of the game.
+     * @return void
+     */
+    void newGame([[maybe_unused]] uint64_t seed) {};
+    /**
+     * @brief Function called before the opponent chooses a move at the console (see Player::ponder). Does nothing by default.
+     * @param currentBoard const BitBoard&. The current game board, the opponent is to move.
+     * @param c char. The symbol of the agent.
+     * @return void
+     */
+    void ponder([[maybe_unused]] const BitBoard& currentBoard, [[maybe_unused]] char c) {};
+    /**
+     * @brief Function called after the opponent chose a move, stops the search started by ponder. Does nothing by default.
+     * @return void
+     */
+    void stopPondering() {};
+    /**
+     * @brief Function to get the statistics of the last move.
+     * @return SearchStats. The statistics, all 0 for agents that do not search.
+     */
+    SearchStats getStats() const {
+        return SearchStats();
+    };
+    /**
+     * @brief The name of what the nodes of getStats count.
+     */
+    static constexpr const char* counted = "nodes";
+    /**
+     * @brief Function to get the symbol of the opponent.
+     * @param c char. The symbol of the agent.
+     * @return char. 'O' for 'X' and 'X' for 'O'.
+     */
+    static constexpr char opponent(char c){
+        return char('X' + 'O' - c);
+    };
+};
+/**
+ * @brief Class to let an agent play at the console.
+ * @class AgentPlayer
+ * @tparam A class. The agent, a subclass of Agent.
+ */
+template<class A>
+class AgentPlayer : public Player {
+public:
+    A agent;
+    CancellationToken moveToken;
+    bool printStats;
+    double deadline;
+    /**
+     * @brief Constructor for the AgentPlayer class.
+     * @param args Args&&. The arguments of the constructor of the agent.
+     */
+    template<class... Args>
+    explicit AgentPlayer(Args&&... args) : agent(std::forward<Args>(args)...), printStats(false), deadline(0) {};
+    /**
+     * @brief Function to choose a field with the agent.
+     * @param currentBoard GameBoard&. The current game board, has to be 3x3.
+     * @param c char. The symbol of the player.
+     * @return int. The field (row*3 + column).
+     * If deadline is set, the agent gets a token that cancels itself after that many seconds. If printStats is set, the statistics of the search 
+     * are printed.
+     */
+    int chooseMove(GameBoard& currentBoard, char c){
+        if (deadline > 0){
+            moveToken.reset(deadline);
+            agent.token = &moveToken;
+        }
+        BitBoard bits = currentBoard.toBitBoard();
+        int cell = agent.chooseMove(bits, c);
+        if (printStats){
+            std::cout << "Search: ";
+            agent.getStats().print(std::cout, A::counted);
+        }
+        return cell;
+    };
+    /**
+     * @brief Function to let the agent search while the opponent chooses a move.
+     * @param currentBoard const GameBoard&. The current game board, has to be 3x3.
+     * @param c char. The symbol of the player.
+     * @return void
+     */
+    void ponder(const GameBoard& currentBoard, char c){
+        agent.ponder(currentBoard.toBitBoard(), c);
+    };
+    /**
+     * @brief Function to stop the search of the agent.
+     * @return void
+     */
+    void stopPondering(){
+        agent.stopPondering();
+    };
+};
+/**
+ * @brief Class to represent a computer player in the Tic Tac Toe game.
+ * @class ComputerPlayer
+ *  The ComputerPlayer class is an Agent that plays the minimax move. AgentPlayer<ComputerPlayer> plays at the console, RandomAgent and EpsilonAgent 
+ * play random moves.
+ */
+class ComputerPlayer : public Agent<ComputerPlayer> {
+public:
+    /**
+     * @brief Struct to represent a move in the game. This is necessary for the minimax algorithm.
+     */
+    struct Move {
+        int row;
+        int column;
+    };
+    /**
+     * @brief The search used by findBestMove. Exhaustive is the plain minimax which expands every move and is kept as a reference, AlphaBeta cuts off
+     * moves that can not change the result.
+     */
+    enum SearchMode { Exhaustive, AlphaBeta };
+    /**
+     * @brief The order in which alphaBeta tries the moves. RowMajor goes through the rows and columns, CentreCornersEdges tries the centre first, then the 
+     * corners and then the edges. KillerHistory additionally tries moves first that caused a cutoff before, at the same depth (killer) or anywhere (history).
+     */
+    enum MoveOrdering { RowMajor, CentreCornersEdges, KillerHistory };
+    TranspositionTable* table;
+    const OpeningBook* book;
+    bool useSolvedTable;
+    SearchMode mode;
+    MoveOrdering ordering;
+    uint64_t nodes;
+    SearchStats stats;
+    int killers[10];
+    uint32_t history[2][9];
+    bool stopped;
+    /**
+     * @brief Constructor for the ComputerPlayer class.
+     * @param ptable TranspositionTable*. The table used by minimax. Defaults to the shared table, nullptr disables it.
+     * @param pmode SearchMode. The search used by findBestMove.
+     * @param pordering MoveOrdering. The move ordering used by alphaBeta.
+     */
+    explicit ComputerPlayer(TranspositionTable* ptable = &TranspositionTable::shared(), SearchMode pmode = AlphaBeta, MoveOrdering pordering = KillerHistory){
+        table = ptable;
+        book = &OpeningBook::shared();
+        useSolvedTable = true;
+        mode = pmode;
+        ordering = pordering;
+        nodes = 0;
+        std::fill(killers, killers + 10, -1);
+        std::fill(&history[0][0], &history[0][0] + 18, 0u);
+        stopped = false;
+    };
+    /**
+     * @brief Getter for the number of nodes the last call of findBestMove searched.
+     * @return uint64_t. The number of positions visited by minimax or alphaBeta.
+     */
+    uint64_t getNodes(){
+        return nodes;
+    };
+    /**
+     * @brief Getter for the statistics of the last call of findBestMove. Only the nodes are counted unless the program is compiled with 
+     * -DTICTACTOE_STATS.
+     * @return SearchStats. The statistics.
+     */
+    SearchStats getStats() const {
+        SearchStats result = stats;
+        result.nodes = nodes;
+        return result;
+    };
+    /**
+     * @brief Function to choose the field of the next move, the minimax move.
+     * @param currentBoard BitBoard&. The current game board. It is the same again when the function returns.
+     * @param c char. The value of the computer.
+     * @return int. The field (row*3 + column).
+     */
+    int chooseMove(BitBoard& currentBoard, char c){
+        Move bestMove = findBestMove(currentBoard, c, opponent(c));
+        return bestMove.row * 3 + bestMove.column;
+    };
+    /**
+     * @brief Minimax algorithm to find the best score for a move. The algorithm goes through all possible moves and returns a score for the best move possible
+     * from the current game state.
+     * @param currentBoard BitBoard. The current game board.
+     * @param depth int. The depth of the algorithm. Similar to the depth of a tree.
+     * @param isMax bool. True if the computer is maximizing, false if the computer is minimizing. Common in the minimax algorithm.
+     * @param c char. The value of the computer. To allow for the algorithm to be player 1 and player 2
+     * @param other char. The value of the other player. To allow for the algorithm to be player 1 and player 2
+     * @return int The score of the best move.
+     * The free fields are visited from the lowest to the highest bit, which is the same order as going through the rows and columns.
+     * Positions that were already searched are taken from the transposition table. The table stores the score from the point of view of the player to move,
+     * so it is negated for the minimizing player.
+     */
+    int minimax(BitBoard& currentBoard, int depth, bool isMax, char c, char other);
+    /**
+     * @brief Adapter for the GameBoard. Converts the board into a BitBoard and runs the minimax search on it.
+     * @param currentBoard GameBoard. The current game board.
+     * @param depth int. The depth of the algorithm.
+     * @param isMax bool. True if the computer is maximizing, false if the computer is minimizing.
+     * @param c char. The value of the computer.
+     * @param other char. The value of the other player.
+     * @return int The score of the best move.
+     */
+    int minimax(GameBoard& currentBoard, int depth, bool isMax, char c, char other);
+    /**
+     * @brief Function to sort the fields in the order alphaBeta should try them.
+     * @param candidates uint16_t. Mask of the fields to sort, usually all free fields.
+     * @param depth int. The depth of the node, used for the killer moves.
+     * @param side int. 0 if X is to move, 1 if O is to move. Used for the history.
+     * @param first int. Field that is always tried first, e.g. the best move from the transposition table. -1 if there is none.
+     * @param moves int*. Array of at least 9 fields which is filled with the sorted fields.
+     * @return int. The number of fields.
+     */
+    int orderMoves(uint16_t candidates, int depth, int side, int first, int* moves);
+    /**
+     * @brief Minimax algorithm with alpha-beta pruning. Returns the same score as minimax whenever the score lies between alpha and beta. Otherwise the 
+     * returned score is only a bound, which is enough since the move can not be chosen anyway.
+     * @param currentBoard BitBoard. The current game board.
+     * @param depth int. The depth of the algorithm.
+     * @param alpha int. The score the maximizing player is already guaranteed.
+     * @param beta int. The score the minimizing player is already guaranteed.
+     * @param isMax bool. True if the computer is maximizing, false if the computer is minimizing.
+     * @param c char. The value of the computer.
+     * @param other char. The value of the other player.
+     * @return int The score of the best move, or a bound on it.
+     * Once a move reaches beta (alpha for the minimizing player) the remaining moves are skipped and the move is remembered as killer and in the history.
+     * The score is stored in the transposition table together with whether it is exact or only a bound. If there is a token, it is checked every 1024 
+     * nodes. Once it is cancelled, stopped is set and every call returns 0 without storing anything, so the table only has complete results.
+     */
+    int alphaBeta(BitBoard& currentBoard, int depth, int alpha, int beta, bool isMax, char c, char other);
+    /**
+     * @brief Function to find the best move for the computer using the minimax algorithm.
+     * @param currentBoard BitBoard. The current game board.
+     * @param c char. The value of the computer. To allow for the algorithm to be player 1 and player 2
+     * @param other char. The value of the other player. To allow for the algorithm to be player 1 and player 2
+     * @return Move. The best move for the computer.
+     * The function goes through all possible moves and uses minimax to find the best possible move after the current move was made. 
+     * After simulating all possible moves for a single move, the function updates the best move if a better move is found. This is repeated for all possible moves.
+     * The best move is then returned. If several moves have the best score, the first one in row and column order is chosen in both search modes.
+     * Moves that lead to a rotation or reflection of the position after an earlier move have the same score and are skipped.
+     * The number of searched nodes is available through getNodes and the statistics through getStats afterwards. In the AlphaBeta mode the move is 
+     * read from the solved table or the opening book if there is one and nothing is searched, otherwise the search stops when the token is cancelled. 
+     * The Exhaustive mode is the reference and always searches to the end.
+     */
+    Move findBestMove(BitBoard& currentBoard, char c, char other);
+    /**
+     * @brief Function to find the best move using alphaBeta. Same result as the exhaustive search.
+     * @param currentBoard BitBoard. The current game board.
+     * @param c char. The value of the computer.
+     * @param other char. The value of the other player.
+     * @return Move. The best move for the computer.
+     * The moves are tried in the order of orderMoves. Every move only has to beat the best score so far, so it is searched with that score as alpha.
+     * A move that comes earlier in row and column order than the current best move also wins on an equal score, so for those alpha is one lower.
+     * The killer moves are reset and the history is halved, so old cutoffs count less than new ones. If the token stops the search, the best of the 
+     * moves searched to the end is played, or the first move of the order if none was.
+     * @param value int*. Set to the score of the best move from the point of view of the computer if the search was not stopped, nullptr to not 
+     * get it. Every move that becomes the best one beats alpha, so its score is exact.
+     */
+    Move findBestMoveAlphaBeta(BitBoard& currentBoard, char c, char other, int* value = nullptr);
+    /**
+     * @brief Adapter for the GameBoard. Converts the board into a BitBoard and searches the best move on it.
+     * @param currentBoard GameBoard. The current game board.
+     * @param c char. The value of the computer.
+     * @param other char. The value of the other player.
+     * @return Move. The best move for the computer.
+     */
+    Move findBestMove(GameBoard& currentBoard, char c, char other);
+};
+/**
+ * @brief Class to represent an agent that plays a random free field.
+ * @class RandomAgent
+ *  The field is taken directly from the set of free fields, so it takes the same time no matter how full the board is.
+ */
+class RandomAgent : public Agent<RandomAgent> {
+public:
+    FastRandom rng;
+    const uint32_t* weights;
+    /**
+     * @brief Constructor for the RandomAgent class.
+     * @param pweights const uint32_t*. The weight of every field, nullptr gives every free field the same chance.
+     */
+    explicit RandomAgent(const uint32_t* pweights = nullptr) : weights(pweights) {
+        rng.reseed(FastRandom::local().next());
+    };
+    /**
+     * @brief Function to start the random numbers again from a seed, so the same moves are played again.
+     * @param seed uint64_t. The seed of the game.
+     * @return void
+     */
+    void newGame(uint64_t seed){
+        rng.reseed(seed);
+    };
+    /**
+     * @brief Function to choose a random free field.
+     * @param currentBoard BitBoard&. The current game board.
+     * @param c char. The symbol of the agent, not needed.
+     * @return int. The field (row*3 + column).
+     */
+    int chooseMove(BitBoard& currentBoard, [[maybe_unused]] char c){
+        uint16_t free = currentBoard.freeCells();
+        return weights ? rng.pickWeighted(free, weights) : rng.pick(free);
+    };
+};
+/**
+ * @brief Class to represent an agent that plays a random field with the chance epsilon and the minimax move otherwise (epsilon-greedy).
+ * @class EpsilonAgent
+ */
+class EpsilonAgent : public Agent<EpsilonAgent> {
+public:
+    ComputerPlayer search;
+    FastRandom rng;
+    double epsilon;
+    bool lastRandom;
+    /**
+     * @brief Constructor for the EpsilonAgent class.
+     * @param pepsilon double. The chance that a move is random, between 0 and 1.
+     */
+    explicit EpsilonAgent(double pepsilon) : epsilon(pepsilon), lastRandom(false) {
+        rng.reseed(FastRandom::local().next());
+    };
+    /**
+     * @brief Function to start the random numbers again from a seed, so the same moves are played again.
+     * @param seed uint64_t. The seed of the game.
+     * @return void
+     */
+    void newGame(uint64_t seed){
+        rng.reseed(seed);
+    };
+    /**
+     * @brief Function to choose a random free field with the chance epsilon, otherwise the minimax move.
+     * @param currentBoard BitBoard&. The current game board. It is the same again when the function returns.
+     * @param c char. The symbol of the agent.
+     * @return int. The field (row*3 + column).
+     */
+    int chooseMove(BitBoard& currentBoard, char c){
+        lastRandom = rng.chance(epsilon);
+        if (lastRandom){
+            return rng.pick(currentBoard.freeCells());
+        }
+        search.token = token;
+        return search.chooseMove(currentBoard, c);
+    };
+    /**
+     * @brief Function to get the statistics of the last move.
+     * @return SearchStats. The statistics of the search, all 0 if the move was random.
+     */
+    SearchStats getStats() const {
+        return lastRandom ? SearchStats() : search.getStats();
+    };
+};
+/**
+ * @brief Class to represent a computer player on a larger board (m,n,k game).
+ * @class MNKComputerPlayer
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ *  The MNKComputerPlayer class is a subclass of the Player class and uses ParallelMNKSearch to find its moves. If ponderEnabled is set, it guesses 
+ * the answer of the opponent while the opponent thinks, from the principal variation of its last search, and searches the position after it on a 
+ * background thread. If the guess was right, the move is ready or the search goes on with a warm transposition table, otherwise the table still 
+ * knows many of the positions.
+ */
+template<int N, int K>
+class MNKComputerPlayer : public Player {
+public:
+    ParallelMNKSearch<N, K> search;
+    PonderThread pondering;
+    MNKBoard<N, K> ponderBoard;
+    int ponderMove;
+    int ponderDepth;
+    double ponderSeconds;
+    CancellationToken moveToken;
+    SearchLimits limits;
+    bool printStats;
+    bool ponderEnabled;
+    double deadline;
+    /**
+     * @brief Constructor for the MNKComputerPlayer class.
+     * @param plimits SearchLimits. The budget for every move, one second by default.
+     * @param threads int. The number of threads to search with, 0 for one per core.
+     */
+    MNKComputerPlayer(SearchLimits plimits = SearchLimits(1.0), int threads = 1) : search(threads), ponderMove(-1), ponderDepth(0), ponderSeconds(0), 
+        limits(plimits), printStats(false), ponderEnabled(false), deadline(0) {};
+    /**
+     * @brief Destructor for the MNKComputerPlayer class. Stops pondering before the search is destroyed.
+     */
+    ~MNKComputerPlayer(){
+        pondering.stop();
+    };
+    /**
+     * @brief Function to choose a field with the search.
+     * @param currentBoard GameBoard&. The current game board, has to be N x N.
+     * @param c char. The symbol of the computer, the board knows whose turn it is.
+     * @return int. The field (row*N + column), -1 if the board is full.
+     * If the board is the one that was pondered on, the pondered move is played when its search is complete or used up the time of the move, 
+     * otherwise the search goes on for the rest of the time. If deadline is set, the move is cut off after that many seconds, even in the first 
+     * iteration. If printStats is set, the depth and the statistics of the search are printed.
+     */
+    int chooseMove(GameBoard& currentBoard, [[maybe_unused]] char c){
+        MNKBoard<N, K> board = currentBoard.toBoard<MNKBoard<N, K>>();
+        bool hit = ponderMove >= 0 && ponderDepth > 0 && ponderBoard == board;
+        int cell = -1;
+        if (hit && (ponderDepth >= board.cells - board.count || (limits.seconds > 0 && ponderSeconds >= limits.seconds) 
+            || (limits.depth > 0 && ponderDepth >= limits.depth))){
+            cell = ponderMove;
+            if (printStats){
+                std::cout << "Ponder hit, depth " << ponderDepth << " after " << ponderSeconds << " s" << std::endl;
+            }
+        } else {
+            SearchLimits moveLimits = limits;
+            if (hit && limits.seconds > 0){
+                moveLimits.seconds = limits.seconds - ponderSeconds;
+            }
+            if (deadline > 0){
+                moveToken.reset(deadline);
+                moveLimits.token = &moveToken;
+            }
+            cell = search.findBestMove(board, moveLimits);
+            if (printStats){
+                if (hit){
+                    std::cout << "Ponder hit, searched " << ponderSeconds << " s before. ";
+                }
+                std::cout << "Search depth " << search.workers[0]->completedDepth << ": ";
+                search.stats().print(std::cout);
+            }
+        }
+        ponderMove = -1;
+        return cell;
+    };
+    /**
+     * @brief Function to search the position after the expected answer of the opponent in the background.
+     * @param currentBoard const GameBoard&. The current game board, the opponent is to move.
+     * @param c char. The symbol of the computer.
+     * @return void
+     * The expected answer is the second move of the principal variation of the last search. If there is none, a short search for the opponent 
+     * finds it, with the same token, so the opponent can still move at any time. ponderSeconds is only the time of the search after the answer, 
+     * which is the time chooseMove can save.
+     */
+    void ponder(const GameBoard& currentBoard, char c){
+        if (!ponderEnabled){
+            return;
+        }
+        MNKBoard<N, K> board = currentBoard.toBoard<MNKBoard<N, K>>();
+        if (board.winner != ' ' || board.isDraw()){
+            return;
+        }
+        ponderMove = -1;
+        ponderDepth = 0;
+        ponderSeconds = 0;
+        pondering.start([this, board, c]() mutable {
+            const std::vector<int>& pv = search.workers[0]->pv;
+            int reply = -1;
+            if (pv.size() >= 2 && !board.isFree(pv[0]) && board.isFree(pv[1])){
+                reply = pv[1];
+            } else {
+                reply = search.findBestMove(board, SearchLimits(0, 0, 2, &pondering.token));
+            }
+            if (reply < 0 || pondering.token.isCancelled()){
+                return;
+            }
+            board.insert(reply, 'X' + 'O' - c);
+            if (board.winner != ' ' || board.isDraw()){
+                return;
+            }
+            ponderBoard = board;
+            auto start = std::chrono::steady_clock::now();
+            int cell = search.findBestMove(board, SearchLimits(0, 0, limits.depth, &pondering.token));
+            ponderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ponderDepth = search.workers[0]->completedDepth;
+            ponderMove = cell;
+        });
+    };
+    /**
+     * @brief Function to stop pondering when the opponent has moved.
+     * @return void
+     */
+    void stopPondering(){
+        pondering.stop();
+    };
+};
+/**
+ * @brief Class to search a position with Monte Carlo Tree Search (UCT). Every iteration walks down the tree to a leaf, picking the child with the best 
+ * upper confidence bound, adds the children of the leaf, plays random moves until the game ends and adds the result to every node on the way.
+ * @class MCTSSearch
+ * @tparam Board class. BitBoard or MNKBoard<N, K>.
+ *  The nodes come from a pool that is allocated once, the children of a node are next to each other, so a node only stores the index of its first 
+ * child. Several threads can search the same tree: a node is expanded by the thread that changes its state from Leaf to Expanding, and the visits 
+ * are counted on the way down, so a node other threads are still playing out looks worse until its result arrives (virtual loss). The tree of the 
+ * position after the opponent's answer is kept for the next search and moved to the front of a second pool, so the pool does not fill up with 
+ * old nodes.
+ */
+template<class Board>
+class MCTSSearch {
+public:
+    enum NodeState : uint8_t { Leaf, Expanding, Expanded };
+    /**
+     * @brief Struct to represent a node of the tree. score is 2 for every win and 1 for every draw of the player who played move.
+     */
+    struct Node {
+        uint32_t firstChild;
+        uint16_t childCount;
+        int16_t move;
+        std::atomic<uint32_t> visits;
+        std::atomic<uint32_t> score;
+        std::atomic<uint8_t> state;
+    };
+    size_t capacity;
+    int threads;
+    uint32_t expandVisits;
+    double exploration;
+    std::unique_ptr<Node[]> pool;
+    std::unique_ptr<Node[]> spare;
+    std::atomic<uint32_t> used;
+    Board rootBoard;
+    bool hasTree;
+    FastRandom rng;
+    SearchStats stats;
+    /**
+     * @brief Constructor for the MCTSSearch class. The pools are allocated by the first search.
+     * @param pcapacity size_t. The number of nodes of the pool. When the pool is full the leaves are not expanded anymore.
+     * @param pthreads int. The number of threads, 0 for one per core.
+     * @param pexpandVisits uint32_t. The number of visits after which a leaf is expanded. More than 1 keeps the tree small on large boards.
+     */
+    MCTSSearch(size_t pcapacity = size_t(1) << 20, int pthreads = 1, uint32_t pexpandVisits = 1) : capacity(std::max<size_t>(pcapacity, 
+        Board::cells + 1)), threads(pthreads > 0 ? pthreads : std::max(1, int(std::thread::hardware_concurrency()))), expandVisits(pexpandVisits), 
+        exploration(1.4), used(0), hasTree(false), rng(FastRandom::local().next()) {};
+    MCTSSearch(MCTSSearch&& other) : capacity(other.capacity), threads(other.threads), expandVisits(other.expandVisits), 
+        exploration(other.exploration), pool(std::move(other.pool)), spare(std::move(other.spare)), used(other.used.load()), 
+        rootBoard(other.rootBoard), hasTree(other.hasTree), rng(other.rng), stats(other.stats) {};
+    /**
+     * @brief Function to start the random numbers again from a seed and forget the tree, e.g. before a new game.
+     * @param seed uint64_t. The seed.
+     * @return void
+     */
+    void reset(uint64_t seed){
+        rng.reseed(seed);
+        hasTree = false;
+    };
+    /**
+     * @brief Function to copy the counters of a node.
+     * @param from const Node&. The node.
+     * @param to Node&. The copy.
+     * @return void
+     */
+    static void copyNode(const Node& from, Node& to){
+        to.firstChild = from.firstChild;
+        to.childCount = from.childCount;
+        to.move = from.move;
+        to.visits.store(from.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.score.store(from.score.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.state.store(from.state.load(std::memory_order_relaxed) == Expanded ? Expanded : Leaf, std::memory_order_relaxed);
+    };
+    /**
+     * @brief Function to set up a new node.
+     * @param node Node&. The node.
+     * @param move int. The field that leads to the node.
+     * @return void
+     */
+    static void initNode(Node& node, int move){
+        node.firstChild = 0;
+        node.childCount = 0;
+        node.move = int16_t(move);
+        node.visits.store(0, std::memory_order_relaxed);
+        node.score.store(0, std::memory_order_relaxed);
+        node.state.store(Leaf, std::memory_order_relaxed);
+    };
+    /**
+     * @brief Function to take nodes from the pool.
+     * @param count uint32_t. The number of nodes.
+     * @return uint32_t. The index of the first node, 0 if the pool is full (0 is always the root).
+     */
+    uint32_t allocate(uint32_t count){
+        uint32_t first = used.load(std::memory_order_relaxed);
+        do {
+            if (first + count > capacity){
+                return 0;
+            }
+        } while (!used.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+        return first;
+    };
+    /**
+     * @brief Function to add the children of a leaf, one for every free field.
+     * @param node Node&. The leaf.
+     * @param board const Board&. The position of the leaf.
+     * @param local SearchStats&. The statistics of the thread.
+     * @return bool. False if another thread is expanding the node or the pool is full.
+     */
+    bool expand(Node& node, const Board& board, [[maybe_unused]] SearchStats& local){
+        uint8_t expected = Leaf;
+        if (!node.state.compare_exchange_strong(expected, Expanding, std::memory_order_acquire)){
+            return false;
+        }
+        int moves[Board::cells];
+        int count = 0;
+        for (int cell = 0; cell < Board::cells; cell++){
+            if (board.isFree(cell)){
+                moves[count++] = cell;
+            }
+        }
+        uint32_t first = allocate(uint32_t(count));
+        if (first == 0){
+            node.state.store(Leaf, std::memory_order_relaxed);
+            return false;
+        }
+        for (int i = 0; i < count; i++){
+            initNode(pool[first + i], moves[i]);
+        }
+        node.firstChild = first;
+        node.childCount = uint16_t(count);
+        SEARCH_STAT(local.expanded++;)
+        SEARCH_STAT(local.children += uint64_t(count);)
+        node.state.store(Expanded, std::memory_order_release);
+        return true;
+    };
+    /**
+     * @brief Function to pick the child with the best upper confidence bound: the share of points plus exploration * sqrt(ln(visits of the node) / 
+     * visits of the child). Children that were never visited come first.
+     * @param node const Node&. An expanded node.
+     * @return uint32_t. The index of the child.
+     */
+    uint32_t select(const Node& node) const {
+        double logVisits = std::log(double(std::max(node.visits.load(std::memory_order_relaxed), 1u)));
+        uint32_t best = node.firstChild;
+        double bestValue = -1.0;
+        for (uint32_t i = node.firstChild; i < node.firstChild + node.childCount; i++){
+            uint32_t visits = pool[i].visits.load(std::memory_order_relaxed);
+            if (visits == 0){
+                return i;
+            }
+            double value = double(pool[i].score.load(std::memory_order_relaxed)) / (2.0 * visits) + exploration * std::sqrt(logVisits / visits);
+            if (value > bestValue){
+                bestValue = value;
+                best = i;
+            }
+        }
+        return best;
+    };
+    /**
+     * @brief Function to play random moves until the game ends.
+     * @param board Board. The position, a copy that is played on.
+     * @param c char. The player to move.
+     * @param random FastRandom&. The random numbers of the thread.
+     * @return char. The winner, ' ' for a draw.
+     */
+    template<class B>
+    static char rollout(B board, char c, FastRandom& random){
+        int free[B::cells];
+        int count = 0;
+        for (int cell = 0; cell < B::cells; cell++){
+            if (board.isFree(cell)){
+                free[count++] = cell;
+            }
+        }
+        while (count > 0){
+            int i = int(random.below(uint32_t(count)));
+            int cell = free[i];
+            free[i] = free[--count];
+            board.insert(cell, c);
+            if (board.isWinner(c)){
+                return c;
+            }
+            c = (c == 'X') ? 'O' : 'X';
+        }
+        return ' ';
+    };
+    /**
+     * @brief Function to play random moves on a BitBoard until the game ends. The free field is picked directly from the mask.
+     * @param board BitBoard. The position, a copy that is played on.
+     * @param c char. The player to move.
+     * @param random FastRandom&. The random numbers of the thread.
+     * @return char. The winner, ' ' for a draw.
+     */
+    static char rollout(BitBoard board, char c, FastRandom& random){
+        for (uint16_t free = board.freeCells(); free; free = board.freeCells()){
+            board.insert(random.pick(free), c);
+            if (board.isWinner(c)){
+                return c;
+            }
+            c = (c == 'X') ? 'O' : 'X';
+        }
+        return ' ';
+    };
+    /**
+     * @brief Function to run one iteration: walk down to a leaf, expand it, play it out and add the result to the nodes on the path.
+     * @param random FastRandom&. The random numbers of the thread.
+     * @param local SearchStats&. The statistics of the thread.
+     * @return void
+     */
+    void iterate(FastRandom& random, SearchStats& local){
+        Board board = rootBoard;
+        uint32_t path[Board::cells + 1];
+        int length = 0;
+        uint32_t current = 0;
+        char c = board.toMove();
+        char winner = ' ';
+        bool finished = false;
+        pool[0].visits.fetch_add(1, std::memory_order_relaxed);
+        path[length++] = 0;
+        while (true){
+            Node& node = pool[current];
+            if (node.state.load(std::memory_order_acquire) != Expanded){
+                if (node.visits.load(std::memory_order_relaxed) < expandVisits || !expand(node, board, local)){
+                    break;
+                }
+            }
+            current = select(node);
+            pool[current].visits.fetch_add(1, std::memory_order_relaxed);
+            path[length++] = current;
+            board.insert(pool[current].move, c);
+            if (board.isWinner(c)){
+                winner = c;
+                finished = true;
+                break;
+            }
+            c = (c == 'X') ? 'O' : 'X';
+            if (board.isDraw()){
+                finished = true;
+                break;
+            }
+        }
+        if (!finished){
+            winner = rollout(board, c, random);
+            SEARCH_STAT(local.leaves++;)
+        }
+        local.nodes++;
+        SEARCH_STAT(local.maxDepth = std::max(local.maxDepth, length - 1);)
+        char mover = rootBoard.toMove();
+        for (int i = 1; i < length; i++){
+            uint32_t points = (winner == mover) ? 2 : (winner == ' ') ? 1 : 0;
+            pool[path[i]].score.fetch_add(points, std::memory_order_relaxed);
+            mover = (mover == 'X') ? 'O' : 'X';
+        }
+    };
+    /**
+     * @brief Function to keep the part of the tree below the new position, if the position is the old root plus one or two moves.
+     * @param board const Board&. The new position.
+     * @return bool. False if the position is not in the tree, the tree has to be started again.
+     * The kept nodes are copied to the front of the spare pool in breadth first order, so the children of a node stay next to each other. While a 
+     * node waits to be copied its firstChild still points into the old pool.
+     */
+    bool reuse(const Board& board){
+        if (!hasTree || pool[0].state.load(std::memory_order_relaxed) != Expanded){
+            return false;
+        }
+        if (board == rootBoard){
+            return true;
+        }
+        uint32_t found = 0;
+        char c = rootBoard.toMove();
+        char other = (c == 'X') ? 'O' : 'X';
+        const Node& root = pool[0];
+        for (uint32_t i = root.firstChild; i < root.firstChild + root.childCount && found == 0; i++){
+            if (board.isFree(pool[i].move)){
+                continue;
+            }
+            Board next = rootBoard;
+            next.insert(pool[i].move, c);
+            if (next == board){
+                found = i;
+                break;
+            }
+            if (pool[i].state.load(std::memory_order_relaxed) != Expanded){
+                continue;
+            }
+            for (uint32_t k = pool[i].firstChild; k < pool[i].firstChild + pool[i].childCount; k++){
+                if (board.isFree(pool[k].move)){
+                    continue;
+                }
+                Board after = next;
+                after.insert(pool[k].move, other);
+                if (after == board){
+                    found = k;
+                    break;
+                }
+            }
+        }
+        if (found == 0){
+            return false;
+        }
+        copyNode(pool[found], spare[0]);
+        uint32_t next = 1;
+        for (uint32_t d = 0; d < next; d++){
+            Node& node = spare[d];
+            if (node.state.load(std::memory_order_relaxed) != Expanded){
+                continue;
+            }
+            uint32_t from = node.firstChild;
+            for (uint32_t i = 0; i < node.childCount; i++){
+                copyNode(pool[from + i], spare[next + i]);
+            }
+            node.firstChild = next;
+            next += node.childCount;
+        }
+        std::swap(pool, spare);
+        used.store(next, std::memory_order_relaxed);
+        rootBoard = board;
+        return true;
+    };
+    /**
+     * @brief Function to find the best move.
+     * @param board const Board&. The current position, the player to move is the one the move is searched for.
+     * @param limits SearchLimits. seconds is the time, nodes the number of iterations, token stops the search from another thread. Without any limit 
+     * 10000 iterations are run.
+     * @return int. The field with the most visits, the lowest one if several have the same number. -1 if the game is over.
+     * The iterations of the old tree below the position are kept. With one thread the same seed always gives the same move for an iteration budget.
+     * If the token stops the search before the root is expanded, the root is expanded afterwards, so there always is a move.
+     */
+    int findBestMove(const Board& board, SearchLimits limits){
+        stats = SearchStats();
+        SearchTimer timer(stats);
+        if (board.isWinner('X') || board.isWinner('O') || board.isDraw()){
+            return -1;
+        }
+        if (!pool){
+            pool.reset(new Node[capacity]);
+            spare.reset(new Node[capacity]);
+        }
+        if (!reuse(board)){
+            rootBoard = board;
+            initNode(pool[0], -1);
+            used.store(1, std::memory_order_relaxed);
+            hasTree = true;
+        }
+        if (limits.seconds <= 0 && limits.nodes == 0 && !limits.token){
+            limits.nodes = 10000;
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(limits.seconds));
+        std::atomic<uint64_t> iterations(0);
+        std::atomic<bool> stop(false);
+        std::vector<SearchStats> local(threads);
+        std::vector<uint64_t> seeds(threads);
+        for (uint64_t& seed : seeds){
+            seed = rng.next();
+        }
+        auto worker = [&](int thread){
+            FastRandom random(seeds[thread]);
+            while (!stop.load(std::memory_order_relaxed)){
+                uint64_t n = iterations.fetch_add(1, std::memory_order_relaxed);
+                if ((limits.nodes && n >= limits.nodes) || (limits.seconds > 0 && n % 64 == 0 && std::chrono::steady_clock::now() >= deadline)
+                    || (limits.token && n % 64 == 0 && limits.token->isCancelled())){
+                    stop.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                iterate(random, local[thread]);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int i = 1; i < threads; i++){
+            workers.emplace_back(worker, i);
+        }
+        worker(0);
+        for (std::thread& thread : workers){
+            thread.join();
+        }
+        for (const SearchStats& s : local){
+            stats.merge(s);
+        }
+        if (pool[0].state.load(std::memory_order_relaxed) != Expanded){
+            // The token stopped the search before the root had enough visits to be expanded, so the move is only a guess: the lowest free field.
+            expand(pool[0], rootBoard, stats);
+        }
+        const Node& root = pool[0];
+        int best = -1;
+        uint32_t bestVisits = 0;
+        for (uint32_t i = root.firstChild; i < root.firstChild + root.childCount; i++){
+            uint32_t visits = pool[i].visits.load(std::memory_order_relaxed);
+            if (best < 0 || visits > bestVisits){
+                best = pool[i].move;
+                bestVisits = visits;
+            }
+        }
+        return best;
+    };
+};
+/**
+ * @brief Class to represent an agent that plays with Monte Carlo Tree Search on the 3x3 board.
+ * @class MCTSAgent
+ */
+class MCTSAgent : public Agent<MCTSAgent> {
+public:
+    MCTSSearch<BitBoard> search;
+    PonderThread pondering;
+    SearchLimits limits;
+    bool ponderEnabled;
+    /**
+     * @brief Constructor for the MCTSAgent class.
+     * @param plimits SearchLimits. The budget for every move, 10000 iterations by default.
+     * @param threads int. The number of threads, 0 for one per core.
+     * The pool has room for the whole game tree of the 3x3 board, or for the iterations of one move if that is less.
+     */
+    MCTSAgent(SearchLimits plimits = SearchLimits(0, 10000), int threads = 1) : search(plimits.nodes && plimits.seconds <= 0 ? 
+        std::min<size_t>(size_t(plimits.nodes) * 9 + 10, size_t(1) << 20) : size_t(1) << 20, threads), limits(plimits), ponderEnabled(false) {};
+    /**
+     * @brief Move constructor for the MCTSAgent class. Moves the search, the agent must not be pondering.
+     * @param other MCTSAgent&&. The agent to move.
+     */
+    MCTSAgent(MCTSAgent&& other) : search(std::move(other.search)), limits(other.limits), ponderEnabled(other.ponderEnabled) {};
+    /**
+     * @brief Destructor for the MCTSAgent class. Stops pondering before the search is destroyed.
+     */
+    ~MCTSAgent(){
+        pondering.stop();
+    };
+    /**
+     * @brief Function to forget the tree and seed the random moves for the next game.
+     * @param seed uint64_t. The seed of the game.
+     * @return void
+     */
+    void newGame(uint64_t seed){
+        search.reset(seed);
+    };
+    /**
+     * @brief Function to choose a move with the search. The tree of the last move is kept if the board continues the last game.
+     * @param currentBoard BitBoard&. The current game board.
+     * @param c char. The symbol of the agent, the board knows whose turn it is.
+     * @return int. The field (row*3 + column).
+     * The token of the agent, if there is one, stops the search in addition to the limits.
+     */
+    int chooseMove(BitBoard& currentBoard, [[maybe_unused]] char c){
+        SearchLimits moveLimits = limits;
+        if (token){
+            moveLimits.token = token;
+        }
+        return search.findBestMove(currentBoard, moveLimits);
+    };
+    /**
+     * @brief Function to grow the tree of the current position in the background while the opponent thinks, if ponderEnabled is set. The next 
+     * search keeps the part below the move the opponent actually played.
+     * @param currentBoard const BitBoard&. The current game board, the opponent is to move.
+     * @param c char. The symbol of the agent.
+     * @return void
+     */
+    void ponder(const BitBoard& currentBoard, [[maybe_unused]] char c){
+        if (!ponderEnabled){
+            return;
+        }
+        pondering.start([this, currentBoard](){
+            search.findBestMove(currentBoard, SearchLimits(0, 0, 0, &pondering.token));
+        });
+    };
+    /**
+     * @brief Function to stop pondering when the opponent has moved.
+     * @return void
+     */
+    void stopPondering(){
+        pondering.stop();
+    };
+    /**
+     * @brief Function to get the statistics of the last move. nodes is the number of iterations.
+     * @return SearchStats. The statistics.
+     */
+    SearchStats getStats() const {
+        return search.stats;
+    };
+    static constexpr const char* counted = "iterations";
+};
+/**
+ * @brief Class to represent a computer player on a larger board that plays with Monte Carlo Tree Search.
+ * @class MNKMCTSPlayer
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ */
+template<int N, int K>
+class MNKMCTSPlayer : public Player {
+public:
+    MCTSSearch<MNKBoard<N, K>> search;
+    PonderThread pondering;
+    CancellationToken moveToken;
+    SearchLimits limits;
+    bool printStats;
+    bool ponderEnabled;
+    double deadline;
+    /**
+     * @brief Constructor for the MNKMCTSPlayer class. A leaf is only expanded after 8 visits, so the tree of a 15x15 board fits into the pool.
+     * @param plimits SearchLimits. The budget for every move, one second by default.
+     * @param threads int. The number of threads, 0 for one per core.
+     */
+    MNKMCTSPlayer(SearchLimits plimits = SearchLimits(1.0), int threads = 1) : search(size_t(1) << 21, threads, 8), limits(plimits), printStats(false), 
+        ponderEnabled(false), deadline(0) {};
+    /**
+     * @brief Destructor for the MNKMCTSPlayer class. Stops pondering before the search is destroyed.
+     */
+    ~MNKMCTSPlayer(){
+        pondering.stop();
+    };
+    /**
+     * @brief Function to choose a field with the search.
+     * @param currentBoard GameBoard&. The current game board, has to be N x N.
+     * @param c char. The symbol of the computer, the board knows whose turn it is.
+     * @return int. The field (row*N + column), -1 if the game is over.
+     * If deadline is set, the search is cut off after that many seconds. If printStats is set, the statistics of the search are printed.
+     */
+    int chooseMove(GameBoard& currentBoard, [[maybe_unused]] char c){
+        SearchLimits moveLimits = limits;
+        if (deadline > 0){
+            moveToken.reset(deadline);
+            moveLimits.token = &moveToken;
+        }
+        int cell = search.findBestMove(currentBoard.toBoard<MNKBoard<N, K>>(), moveLimits);
+        if (printStats){
+            std::cout << "MCTS: ";
+            search.stats.print(std::cout, "iterations");
+        }
+        return cell;
+    };
+    /**
+     * @brief Function to grow the tree of the current position in the background while the opponent thinks, if ponderEnabled is set. The next 
+     * search keeps the part below the move the opponent actually played.
+     * @param currentBoard const GameBoard&. The current game board, the opponent is to move.
+     * @param c char. The symbol of the computer.
+     * @return void
+     */
+    void ponder(const GameBoard& currentBoard, [[maybe_unused]] char c){
+        if (!ponderEnabled){
+            return;
+        }
+        pondering.start([this, board = currentBoard.toBoard<MNKBoard<N, K>>()](){
+            search.findBestMove(board, SearchLimits(0, 0, 0, &pondering.token));
+        });
+    };
+    /**
+     * @brief Function to stop pondering when the opponent has moved.
+     * @return void
+     */
+    void stopPondering(){
+        pondering.stop();
+    };
+};
+/**
+ * @brief Function to solve every position that can be reached from the empty board and write the opening book file.
+ * @param path const char*. The path of the file.
+ * @return bool. True if the file was written.
+ * Goes through all positions with a depth first search from the empty board, X moving first. For every position that is not finished the best move is 
+ * found with findBestMove and the score with a full window alphaBeta, so the book plays exactly the same moves as the search.
+ */
+bool generateOpeningBook(const char* path);
+/**
+ * @brief Struct to describe an agent of the batch self-play by its name, so every thread can create its own agents.
+ */
+struct AgentSpec {
+    /**
+     * @brief The kind of agent, every kind is its own Agent class.
+     */
+    enum Kind { Minimax, Random, Epsilon, MCTS };
+    Kind kind;
+    double epsilon;
+    const uint32_t* weights;
+    uint64_t iterations;
+    /**
+     * @brief Function to read the agent from its name.
+     * @param name const std::string&. "minimax", "random", "weighted" (random, the centre three times and the corners twice as likely as an edge) or 
+     * "epsilon:<p>" (a random move with the chance p, otherwise the minimax move), "mcts" or "mcts:<n>" (Monte Carlo Tree Search with n iterations 
+     * per move, 1000 by default).
+     * @return bool. False if the name is unknown.
+     * "epsilon:0" is the minimax agent and "epsilon:1" the random agent, so they play exactly like them.
+     */
+    bool parse(const std::string& name);
+    /**
+     * @brief Function to call a function with a callable that creates the agent, so the caller knows the type of the agent at compile time. The 
+     * minimax search uses the shared transposition table, which works without locks, MCTS searches with one thread, the self-play already uses 
+     * all cores.
+     * @tparam Visitor class. A generic callable that takes the creating callable.
+     * @param visitor Visitor. The function.
+     * @return The result of the function, which has to be the same for every kind.
+     */
+    template<class Visitor>
+    auto visit(Visitor visitor) const {
+        switch (kind){
+            case Random:
+                return visitor([this](){ return RandomAgent(weights); });
+            case Epsilon:
+                return visitor([this](){ return EpsilonAgent(epsilon); });
+            case MCTS:
+                return visitor([this](){ return MCTSAgent(SearchLimits(0, iterations), 1); });
+            default:
+                return visitor([](){ return ComputerPlayer(); });
+        }
+    };
+};
+/**
+ * @brief Class to count move times in buckets that grow exponentially, so percentiles can be read without keeping every time.
+ * @class LatencyHistogram
+ *  Every power of two is split into 8 buckets, so a percentile is at most 12.5% too high.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int subBuckets = 8;
+    uint64_t counts[64 * subBuckets];
+    uint64_t total;
+    uint64_t maximum;
+    /**
+     * @brief Constructor for the LatencyHistogram class.
+     */
+    LatencyHistogram() : total(0), maximum(0) {
+        std::fill(counts, counts + 64 * subBuckets, 0);
+    };
+    /**
+     * @brief Function to get the bucket of a time.
+     * @param ns uint64_t. The time in nanoseconds.
+     * @return int. The bucket.
+     */
+    static int bucket(uint64_t ns){
+        if (ns < subBuckets){
+            return int(ns);
+        }
+        int exponent = 63 - __builtin_clzll(ns);
+        return exponent * subBuckets + int((ns >> (exponent - 3)) & (subBuckets - 1));
+    };
+    /**
+     * @brief Function to get the largest time that falls into a bucket.
+     * @param index int. The bucket.
+     * @return uint64_t. The time in nanoseconds.
+     */
+    static uint64_t upperBound(int index);
+    /**
+     * @brief Function to count a time.
+     * @param ns uint64_t. The time in nanoseconds.
+     * @return void
+     */
+    void add(uint64_t ns){
+        counts[bucket(ns)]++;
+        total++;
+        maximum = std::max(maximum, ns);
+    };
+    /**
+     * @brief Function to add the counts of another histogram.
+     * @param other const LatencyHistogram&. The histogram.
+     * @return void
+     */
+    void merge(const LatencyHistogram& other);
+    /**
+     * @brief Function to get a percentile.
+     * @param fraction double. The percentile as a fraction, e.g. 0.99.
+     * @return uint64_t. The time in nanoseconds that this fraction of the moves were faster than or equal to.
+     */
+    uint64_t percentile(double fraction) const;
+};
+/**
+ * @brief Struct to represent the result of a batch self-play run.
+ */
+struct SelfPlayResult {
+    uint64_t games;
+    uint64_t firstWins;
+    uint64_t draws;
+    uint64_t secondWins;
+    double seconds;
+    LatencyHistogram latency[2];
+    SearchStats stats[2];
+    /**
+     * @brief Function to add the counts of another result, the times are added too.
+     * @param other const SelfPlayResult&. The other result.
+     * @return void
+     */
+    void merge(const SelfPlayResult& other);
+};
+/**
+ * @brief Function to get the seed of one game, so every game gets the same seed no matter which thread plays it (splitmix64).
+ * @param seed uint64_t. The seed of the run.
+ * @param game uint64_t. The number of the game.
+ * @return uint64_t. The seed of the game.
+ */
+uint64_t gameSeed(uint64_t seed, uint64_t game);
+/**
+ * @brief Function to play many games between two agents without any input or output.
+ * @tparam MakeFirst class. Callable that creates the first agent, a subclass of Agent.
+ * @tparam MakeSecond class. Callable that creates the second agent.
+ * @param makeFirst MakeFirst. Called once by every thread.
+ * @param makeSecond MakeSecond. Called once by every thread.
+ * @param games uint64_t. The number of games.
+ * @param threads int. The number of threads, 0 for one per core.
+ * @param seed uint64_t. The seed of the run. The same seed plays the same games.
+ * @param records std::vector<GameRecordArena>*. Set to one arena per chunk of 256 games, so going through the arenas in order gives the games in 
+ * the order of their numbers, whichever thread played them. nullptr to not record the games. Arenas from an earlier run are cleared and their 
+ * memory is used again.
+ * @param firstGame uint64_t. The number of the first game, so a long run can be played in parts that play the same games as one run.
+ * @return SelfPlayResult. The wins, draws and losses of the first agent, the time, the move times and the search statistics of both agents.
+ * The first agent plays X in the even games and O in the odd games. The threads take games from a shared counter in chunks of 256 and keep their 
+ * own counts, which are added up at the end. The types of the agents are known here, so the moves are chosen without virtual calls and without 
+ * checking whose turn it is, the loop alternates between the X and the O agent.
+ */
+template<class MakeFirst, class MakeSecond>
+SelfPlayResult runSelfPlayAgents(MakeFirst makeFirst, MakeSecond makeSecond, uint64_t games, int threads, uint64_t seed, 
+    std::vector<GameRecordArena>* records, uint64_t firstGame){
+    if (threads <= 0){
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+    static constexpr uint64_t chunk = 256;
+    if (records){
+        while (records->size() < (games + chunk - 1) / chunk){
+            records->emplace_back(chunk * 9);
+        }
+        for (GameRecordArena& arena : *records){
+            arena.clear();
+        }
+    }
+    std::atomic<uint64_t> nextGame(0);
+    std::vector<SelfPlayResult> results(threads, SelfPlayResult());
+    auto worker = [&](int thread){
+        auto first = makeFirst();
+        auto second = makeSecond();
+        SelfPlayResult& result = results[thread];
+        BitBoard board;
+        uint8_t moves[9];
+        int length = 0;
+        auto turn = [&](auto& agent, int index, char c){
+            auto moveStart = std::chrono::steady_clock::now();
+            int cell = agent.chooseMove(board, c);
+            auto moveEnd = std::chrono::steady_clock::now();
+            result.latency[index].add(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(moveEnd - moveStart).count()));
+            result.stats[index].merge(agent.getStats());
+            board.insert(cell, c);
+            moves[length++] = uint8_t(cell);
+            return board.isWinner(c) || board.isDraw();
+        };
+        auto play = [&](auto& xAgent, int xIndex, auto& oAgent){
+            while (!turn(xAgent, xIndex, 'X') && !turn(oAgent, xIndex ^ 1, 'O')){
+            }
+        };
+        for (uint64_t start = nextGame.fetch_add(chunk); start < games; start = nextGame.fetch_add(chunk)){
+            for (uint64_t game = firstGame + start; game < firstGame + std::min(start + chunk, games); game++){
+                uint64_t seedOfGame = gameSeed(seed, game);
+                first.newGame(seedOfGame);
+                second.newGame(seedOfGame ^ 0xA5A5A5A5A5A5A5A5ull);
+                board = BitBoard();
+                length = 0;
+                if (game & 1){
+                    play(second, 1, first);
+                } else {
+                    play(first, 0, second);
+                }
+                char winner = board.isWinner('X') ? 'X' : board.isWinner('O') ? 'O' : 'D';
+                if (records){
+                    (*records)[start / chunk].add(moves, size_t(length), 3, winner);
+                }
+                result.games++;
+                if (winner == 'D'){
+                    result.draws++;
+                } else if ((winner == 'X') == ((game & 1) == 0)){
+                    result.firstWins++;
+                } else {
+                    result.secondWins++;
+                }
+            }
+        }
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++){
+        pool.emplace_back(worker, i);
+    }
+    worker(0);
+    for (std::thread& thread : pool){
+        thread.join();
+    }
+    SelfPlayResult total = SelfPlayResult();
+    for (const SelfPlayResult& result : results){
+        total.merge(result);
+    }
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+};
+/**
+ * @brief Function to play many games between two agents given by their names (see AgentSpec).
+ * @param first const std::string&. The name of the first agent.
+ * @param second const std::string&. The name of the second agent.
+ * @param games uint64_t. The number of games.
+ * @param threads int. The number of threads, 0 for one per core.
+ * @param seed uint64_t. The seed of the run.
+ * @param records std::vector<GameRecordArena>*. Set to the games, one arena per chunk of 256 games in the order of the games, nullptr to not record 
+ * the games (see runSelfPlayAgents).
+ * @param firstGame uint64_t. The number of the first game.
+ * @return SelfPlayResult. The results, no games if one of the names is unknown.
+ */
+SelfPlayResult runSelfPlay(const std::string& first, const std::string& second, uint64_t games, int threads, uint64_t seed, 
+    std::vector<GameRecordArena>* records = nullptr, uint64_t firstGame = 0);
+/**
+ * @brief Class to score many positions at once, e.g. for training data or analysis.
+ * @class PositionEvaluator
+ *  A position is its base 3 index (BitBoard::index) as uint16_t, the player to move follows from the number of X and O (X starts). The result of a 
+ * position is an OpeningBook::Entry: the minimax value from the point of view of the player to move (10 win, 0 draw, -10 loss) and the best field. 
+ * Finished positions have the best field -1, invalid positions the value PositionEvaluator::invalid. A won position is only valid if its line 
+ * needs one of the fields of the winner, so the line could have come with the last move.
+ *  The positions are cut into blocks of blockSize, which the threads take from a shared counter, so every thread works on a contiguous part of the 
+ * input and output. The files start with a FileHeader followed by the positions (uint16_t) or the results (two int8_t), and are read and written in 
+ * chunks, so they can be larger than the memory.
+ */
+class PositionEvaluator {
+public:
+    /**
+     * @brief Struct to represent the header of a position or result file.
+     */
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t count;
+    };
+    static constexpr int8_t invalid = INT8_MIN;
+    static constexpr size_t blockSize = 4096;
+    static constexpr size_t chunkSize = size_t(1) << 20;
+    static constexpr uint32_t version = 1;
+    static constexpr char positionMagic[4] = {'T', 'T', 'T', 'P'};
+    static constexpr char resultMagic[4] = {'T', 'T', 'T', 'V'};
+    /**
+     * @brief Function to score one position.
+     * @param position uint16_t. The base 3 index of the position.
+     * @param engine ComputerPlayer&. The computer player of the thread, only used if the solved table is not compiled in and no opening book is loaded.
+     * @return OpeningBook::Entry. The value and the best field.
+     */
+    static OpeningBook::Entry evaluate(uint16_t position, ComputerPlayer& engine);
+    /**
+     * @brief Function to score an array of positions.
+     * @param positions const uint16_t*. The positions.
+     * @param results OpeningBook::Entry*. Set to the result of every position.
+     * @param count size_t. The number of positions.
+     * @param threads int. The number of threads, 0 for one per core. Fewer threads are used if there are not enough blocks.
+     * @return void
+     */
+    static void evaluateBatch(const uint16_t* positions, OpeningBook::Entry* results, size_t count, int threads);
+    /**
+     * @brief Function to find the terminal status (see TerminalKernel) of an array of boards with the fastest kernel of the CPU.
+     * @param boards const BitBoard*. The boards.
+     * @param status uint8_t*. Set to the status of every board.
+     * @param count size_t. The number of boards.
+     * @param threads int. The number of threads, 0 for one per core. Fewer threads are used if there are not enough blocks.
+     * @return void
+     */
+    static void terminalStatus(const BitBoard* boards, uint8_t* status, size_t count, int threads = 1);
+    /**
+     * @brief Function to score a position file and write a result file, one chunk at a time.
+     * @param inPath const char*. The position file.
+     * @param outPath const char*. The result file, written in the same order.
+     * @param threads int. The number of threads, 0 for one per core.
+     * @return uint64_t. The number of positions scored, 0 if a file could not be read or written.
+     * The results are written to outPath with ".tmp" appended and renamed to outPath once all positions are scored, so a truncated position file 
+     * or a failed write never leaves a partial result file behind.
+     */
+    static uint64_t evaluateFile(const char* inPath, const char* outPath, int threads);
+    /**
+     * @brief Function to write a position file with random positions that can happen in a game, to have input for evaluateFile.
+     * @param path const char*. The file.
+     * @param count uint64_t. The number of positions.
+     * @param seed uint64_t. The seed of the random moves.
+     * @return bool. True if the file was written.
+     * Every position is made by 0 to 8 random moves from the empty board, a game that is over stops early.
+     */
+    static bool writePositions(const char* path, uint64_t count, uint64_t seed);
+};
+#endif
@@ -1,590 +1,1234 @@
-#include <iostream>
-#include <random>
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <unordered_map>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "ui.h"
 /**
- * @brief Class to represent a Tic Tac Toe game board. The game board is a 3x3 grid with each field being either free or occupied by a player.
- * @class GameBoard
- *  The 3x3 grid is an array of Fields which are either free or occupied by a player. Since a value can only be X or O, a boolean is used to represent the value. 
- * True represents X and False represents O. A boolean is also used to represent if the field is free or occupied. True represents free and False represents occupied.
+ * @brief Function to run the batch self-play and print the results.
+ * @param first const std::string&. The name of the first agent.
+ * @param second const std::string&. The name of the second agent.
+ * @param games uint64_t. The number of games.
+ * @param threads int. The number of threads, 0 for one per core.
+ * @param seed uint64_t. The seed of the run.
+ * @param log GameLogWriter*. The game log the games are written to, nullptr to not write them. The games are then played in parts of 2^20 
+ * games, so they never all have to be in memory.
+ * @return bool. False if one of the agents is unknown.
  */
-class GameBoard {
-public:
-    /**
-     * @brief Struct to represent a field on the game board. A field can either be free or occupied by a player. A field can also have a value of X or O. represented by a boolean.
-     */
-    struct Field {
-    bool isFree;
-    bool isValueX;
-    /**
-     * @brief Constructor for the Field struct. Initializes the field as free and with is ValueX as false. This means that when checking for the winner i always 
-     * have to check if the field is free or not. If the field is not free, then i can check if the value is X or O. If I do not do this it will lead to a bug.
-     *  In hindsight, I should have just used a char to represent the value of the field. This would have made it easier.
-     */
-    Field() : isFree(true), isValueX(false) {};
-    /**
-     * @brief Getter for the isFree attribute of the field.
-     * @return bool. True if the field is free, false if the field is occupied.
-     */
-    bool getFree() { return isFree; };
-    /**
-     * @brief Getter for the isValueX attribute of the field.
-     * @return char. Returns 'X' if the field is occupied by X, 'O' if the field is occupied by O.
-     */
-    char getValue() {
-        if(isValueX){
-            return 'X';
-        } else {
-            return 'O';
-        }
-        };
-    /**
-     * @brief Setter for the isFree attribute of the field.
-     * @param free bool. 
-     */
-    void setFree(bool free) { isFree = free; };
-    /**
-     * @brief Setter for the isValueX attribute of the field.
-     * @param value bool. True if the field is shall be occupied by X, false if the field shall be occupied by O.
-     */
-    void setValue(bool value) { isValueX = value; };
-    };
-
-    Field board[3][3];
-    /**
-     * @brief Constructor for the GameBoard class. Initializes the game board as a 3x3 using the Field struct.
-     */
-    GameBoard(){
-        for (int i = 0; i < 3; i++){
-            for (int j = 0; j < 3; j++){
-                board[i][j] = Field();
+bool printSelfPlay(const std::string& first, const std::string& second, uint64_t games, int threads, uint64_t seed, GameLogWriter* log = nullptr){
+    AgentSpec spec;
+    if (!spec.parse(first) || !spec.parse(second)){
+        std::cout << "Unknown agent, use minimax, random, weighted, epsilon:<p>, mcts or mcts:<n>." << std::endl;
+        return false;
+    }
+    SelfPlayResult result = SelfPlayResult();
+    if (!log){
+        result = runSelfPlay(first, second, games, threads, seed);
+    } else {
+        static constexpr uint64_t part = uint64_t(1) << 20;
+        std::vector<GameRecordArena> records;
+        for (uint64_t played = 0; played < games; played += part){
+            result.merge(runSelfPlay(first, second, std::min(part, games - played), threads, seed, &records, played));
+            for (const GameRecordArena& arena : records){
+                log->add(arena);
             }
         }
-    };
-    /**
-     * @brief Function to print a row of the game board. Uses ASCII art to represent the game board.
-     * @param row int. The row to be printed
-     * @return void
-     * method cout.put was used since we were supposed to use ASCII art. I hope this satisfies the requirement. 32 represents a space, 
-     * 124 represents a vertical line, 88 represents an X, 79 represents an O.
-     */
-    void printrow(int row){
-        std::cout << row+1;
-        std::cout.put(32).put(124);
-        for(int i = 0; i < 3; i++){
-            if (board[row][i].getFree()){
-                std::cout.put(32).put(32).put(32).put(124);
-            } else if (board[row][i].getValue()=='X'){
-                std::cout.put(32).put(88).put(32).put(124);
-            } else {
-                std::cout.put(32).put(79).put(32).put(124);
-            }
+    }
+    std::string names[2] = {first, second};
+    if (first == second){
+        names[0] += " 1";
+        names[1] += " 2";
+    }
+    double percent = result.games ? 100.0 / double(result.games) : 0.0;
+    std::cout << result.games << " games " << names[0] << " vs " << names[1] << ", seed " << seed << std::endl;
+    std::cout << names[0] << " wins: " << double(result.firstWins) * percent << "%, draws: " << double(result.draws) * percent << "%, " 
+        << names[1] << " wins: " << double(result.secondWins) * percent << "%" << std::endl;
+    std::cout << "Time: " << result.seconds << " s, " << double(result.games) / result.seconds << " games/s" << std::endl;
+    for (int agent = 0; agent < 2; agent++){
+        const LatencyHistogram& latency = result.latency[agent];
+        std::cout << "Move time of " << names[agent] << " (ns): p50 " << latency.percentile(0.5) << ", p90 " << latency.percentile(0.9)
+            << ", p99 " << latency.percentile(0.99) << ", max " << latency.maximum << std::endl;
+#ifdef TICTACTOE_STATS
+        std::cout << "Search of " << names[agent] << ": ";
+        result.stats[agent].print(std::cout, names[agent].compare(0, 4, "mcts") == 0 ? "iterations" : "nodes");
+#endif
+    }
+    return true;
+};
+#ifdef TICTACTOE_BENCH
+/**
+ * @brief Counter of the calls of operator new in the benchmark build, so the benchmarks can report the allocations per operation. Every form of 
+ * operator new and delete is replaced (arrays, aligned and nothrow), so all memory comes from and goes back to malloc and free.
+ */
+static std::atomic<uint64_t> benchAllocations(0);
+/**
+ * @brief Function to give memory back for the replaced operator delete. It is not inlined, so the compiler does not see free on memory that came 
+ * from new.
+ * @param memory void*. The memory, may be nullptr.
+ * @return void
+ */
+[[gnu::noinline]] static void benchFree(void* memory) noexcept {
+    std::free(memory);
+};
+/**
+ * @brief Function to allocate memory for the replaced operator new and count the allocation.
+ * @param size size_t. The number of bytes.
+ * @param alignment size_t. The alignment, 0 for the alignment of malloc.
+ * @return void*. The memory, nullptr if there is none.
+ */
+static void* benchAllocate(size_t size, size_t alignment) noexcept {
+    benchAllocations.fetch_add(1, std::memory_order_relaxed);
+    size = size ? size : 1;
+    if (alignment <= alignof(std::max_align_t)){
+        return std::malloc(size);
+    }
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+};
+void* operator new(size_t size){
+    if (void* memory = benchAllocate(size, 0)){
+        return memory;
+    }
+    throw std::bad_alloc();
+};
+void* operator new[](size_t size){
+    if (void* memory = benchAllocate(size, 0)){
+        return memory;
+    }
+    throw std::bad_alloc();
+};
+void* operator new(size_t size, std::align_val_t alignment){
+    if (void* memory = benchAllocate(size, size_t(alignment))){
+        return memory;
+    }
+    throw std::bad_alloc();
+};
+void* operator new[](size_t size, std::align_val_t alignment){
+    if (void* memory = benchAllocate(size, size_t(alignment))){
+        return memory;
+    }
+    throw std::bad_alloc();
+};
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return benchAllocate(size, 0);
+};
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return benchAllocate(size, 0);
+};
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return benchAllocate(size, size_t(alignment));
+};
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return benchAllocate(size, size_t(alignment));
+};
+void operator delete(void* memory) noexcept {
+    benchFree(memory);
+};
+void operator delete[](void* memory) noexcept {
+    benchFree(memory);
+};
+void operator delete(void* memory, size_t) noexcept {
+    benchFree(memory);
+};
+void operator delete[](void* memory, size_t) noexcept {
+    benchFree(memory);
+};
+void operator delete(void* memory, std::align_val_t) noexcept {
+    benchFree(memory);
+};
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    benchFree(memory);
+};
+void operator delete(void* memory, size_t, std::align_val_t) noexcept {
+    benchFree(memory);
+};
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept {
+    benchFree(memory);
+};
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    benchFree(memory);
+};
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    benchFree(memory);
+};
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    benchFree(memory);
+};
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    benchFree(memory);
+};
+#endif
+/**
+ * @brief Struct to represent the result of one benchmark.
+ */
+struct BenchResult {
+    std::string name;
+    uint64_t ops;
+    double nsPerOp;
+    uint64_t nodes;
+    double nodesPerSecond;
+    double allocationsPerOp;
+    SearchStats stats;
+};
+/**
+ * @brief Function to run one benchmark. The operation is repeated in batches that double in size until the batch takes at least minSeconds.
+ * @tparam Operation class. Callable that runs the operation once and returns the statistics of its search (all 0 if it does not search).
+ * @param name const char*. The name of the benchmark in the output.
+ * @param operation Operation. The operation.
+ * @param minSeconds double. The minimum time of the measured batch.
+ * @return BenchResult. The time per operation, the nodes per second, the allocations per operation (-1 if allocations are not counted) and the search 
+ * statistics of the measured batch added up.
+ */
+template<class Operation>
+BenchResult runBench(const char* name, Operation operation, double minSeconds = 0.25){
+    BenchResult result;
+    result.name = name;
+    for (uint64_t batch = 1; ; batch *= 2){
+#ifdef TICTACTOE_BENCH
+        uint64_t allocationsBefore = benchAllocations.load();
+#endif
+        SearchStats stats;
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < batch; i++){
+            stats.merge(operation());
         }
-        std::cout.put('\n');
-    };
-    /**
-     * @brief Function to print a seperator line between the rows of the game board. Uses 13 dashes since to exactly match the provided screenshot.
-     * @return void
-     * method cout.put was used since we were supposed to use ASCII art. I hope this satisfies the requirement. 32 represents a space, 45 represents a dash.
-     */
-    void printseperator(){
-        std::cout.put(32).put(32);
-        for (int i = 0;i<13;i++){
-            std::cout.put(45);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds >= minSeconds || batch >= (uint64_t(1) << 40)){
+            result.ops = batch;
+            result.nsPerOp = seconds * 1e9 / double(batch);
+            result.nodes = stats.nodes;
+            result.nodesPerSecond = double(stats.nodes) / seconds;
+            result.stats = stats;
+#ifdef TICTACTOE_BENCH
+            result.allocationsPerOp = double(benchAllocations.load() - allocationsBefore) / double(batch);
+#else
+            result.allocationsPerOp = -1;
+#endif
+            return result;
         }
-        std::cout.put('\n');
-    };
-    /**
-     * @brief Function to print the game board. Uses ASCII art to represent the game board.
-     * @return void
-     * First prints the column numbers and a seperator line. Then prints each row and a seperator line after each row.
-     */
-    void printBoard(){
-        std::cout << "    1   2   3" << std::endl;
-        printseperator();
-        for (int k=0;k<3;k++){
-            printrow(k);
-            printseperator();
+    }
+};
+/**
+ * @brief Function to benchmark the hot paths of the 3x3 engine and print the results as JSON.
+ * @return void
+ * Mid-game positions are sampled with random moves from a fixed seed, so every run measures the same positions. The searches from mid-game positions 
+ * and the findBestMove search latency use a fresh transposition table for every call, so every call does the full work. With -DTICTACTOE_STATS 
+ * the search statistics are added to every benchmark.
+ */
+void runBenchmarks(){
+    static constexpr int samples = 64;
+    FastRandom rng(12345);
+    std::vector<GameBoard> boards;
+    std::vector<BitBoard> positions;
+    std::vector<char> toMove;
+    while (int(boards.size()) < samples){
+        BitBoard position;
+        int stones = 2 + int(rng.below(5));
+        char c = 'X';
+        for (int i = 0; i < stones && !position.isWinner('X') && !position.isWinner('O'); i++){
+            position.insert(rng.pick(position.freeCells()), c);
+            c = (c == 'X') ? 'O' : 'X';
         }
-    };
-    /**
-     * @brief Destructor for the GameBoard class.
-     */
-    ~GameBoard(){};
-    /**
-     * @brief Function to insert a value into a field on the game board.
-     * @param row int. The row of the field to be inserted into.
-     * @param column int. The column of the field to be inserted into.
-     * @param c char. The value to be inserted into the field. 'X' for X, 'O' for O.
-     * @return void
-     * If the field is free, the value is inserted into the field. If the field is not free, the value is not inserted.
-     */
-    void insert(int row, int column, char c){
-        if (board[row][column].getFree()){
-            if(c == 'X'){
-                board[row][column].setValue(true);
-                board[row][column].setFree(false);
-            } else if (c == 'O'){
-                board[row][column].setValue(false);
-                board[row][column].setFree(false);
-            }
+        if (position.isWinner('X') || position.isWinner('O') || position.isDraw()){
+            continue;
         }
-
-    };
-    /**
-     * @brief Function to remove a value from a field on the game board.
-     * @param row int. The row of the field to be removed from.
-     * @param column int. The column of the field to be removed from.
-     * @return void
-     * Sets the field as free. Used for the minimax algorithm.
-     */
-    void refree(int row, int column){
-        board[row][column].setFree(true);
-    };
-    /**
-     * @brief Function to check if a field is free or occupied.
-     * @param row int. The row of the field to be checked.
-     * @param column int. The column of the field to be checked.
-     * @return bool. True if the field is free, false if the field is occupied.
-     */
-    bool isFree(int row, int column){
-        if (board[row][column].getFree()){
-            return true;
-        } else {
-            return false;
+        GameBoard board;
+        for (int cell = 0; cell < 9; cell++){
+            if (position.x & (1 << cell)){
+                board.insert(cell / 3, cell % 3, 'X');
+            } else if (position.o & (1 << cell)){
+                board.insert(cell / 3, cell % 3, 'O');
+            }
         }
-    };
-    /**
-     * @brief Function to check if a player has won the game.
-     * @param c char. The player to be checked. 'X' for X, 'O' for O.
-     * @return bool. True if the player has won, false if the player has not won.
-     * Checks if the player has won by checking if the player has occupied all fields in a row, column or diagonal.
-     */
-    bool isWinner(char c){
-        for (int i = 0; i < 3; i++){
-            if (board[i][0].getValue() == board[i][1].getValue() && board[i][1].getValue() == board[i][2].getValue() && board[i][0].getValue() == c){
-                if(board[i][0].getFree() == false && board[i][1].getFree() == false && board[i][2].getFree() == false){
-                    return true;
-                }
+        boards.push_back(board);
+        positions.push_back(position);
+        toMove.push_back(c);
+    }
+    volatile int sink = 0;
+    size_t next = 0;
+    std::vector<BenchResult> results;
+    results.push_back(runBench("GameBoard::isWinner", [&](){
+        GameBoard& board = boards[next++ % samples];
+        sink = sink + board.isWinner('X') + board.isWinner('O');
+        return SearchStats();
+    }));
+    results.push_back(runBench("GameBoard::isDraw", [&](){
+        sink = sink + boards[next++ % samples].isDraw();
+        return SearchStats();
+    }));
+    results.push_back(runBench("GameBoard::insert+refree", [&](){
+        size_t i = next++ % samples;
+        GameBoard& board = boards[i];
+        uint16_t free = positions[i].freeCells();
+        int cell = __builtin_ctz(free);
+        board.insert(cell / 3, cell % 3, toMove[i]);
+        board.refree(cell / 3, cell % 3);
+        return SearchStats();
+    }));
+    std::vector<BitBoard> statusBoards(4096);
+    for (BitBoard& board : statusBoards){
+        uint16_t cells = uint16_t(rng.below(512));
+        board.x = uint16_t(rng.below(512)) & cells;
+        board.o = uint16_t(~board.x) & cells;
+    }
+    std::vector<uint8_t> status(statusBoards.size());
+    for (const TerminalKernel& kernel : TerminalKernel::available()){
+        std::string name = std::string("terminal status 4096 boards (") + kernel.name + ")";
+        results.push_back(runBench(name.c_str(), [&](){
+            kernel.run(statusBoards.data(), status.data(), statusBoards.size());
+            sink = sink + status[next++ % statusBoards.size()];
+            return SearchStats();
+        }));
+    }
+    results.push_back(runBench("minimax empty board (no table)", [&](){
+        ComputerPlayer player(nullptr, ComputerPlayer::Exhaustive);
+        BitBoard empty;
+        sink = sink + player.minimax(empty, 0, true, 'X', 'O');
+        return player.getStats();
+    }, 1.0));
+    results.push_back(runBench("minimax empty board", [&](){
+        TranspositionTable table(size_t(1) << 16);
+        ComputerPlayer player(&table, ComputerPlayer::Exhaustive);
+        BitBoard empty;
+        sink = sink + player.minimax(empty, 0, true, 'X', 'O');
+        return player.getStats();
+    }));
+    results.push_back(runBench("minimax mid-game (no table)", [&](){
+        size_t i = next++ % samples;
+        ComputerPlayer player(nullptr, ComputerPlayer::Exhaustive);
+        char other = (toMove[i] == 'X') ? 'O' : 'X';
+        sink = sink + player.minimax(positions[i], 0, true, toMove[i], other);
+        return player.getStats();
+    }));
+    results.push_back(runBench("alphaBeta mid-game", [&](){
+        size_t i = next++ % samples;
+        TranspositionTable table(size_t(1) << 12);
+        ComputerPlayer player(&table);
+        char other = (toMove[i] == 'X') ? 'O' : 'X';
+        sink = sink + player.alphaBeta(positions[i], 0, -1000, 1000, true, toMove[i], other);
+        return player.getStats();
+    }));
+    results.push_back(runBench("findBestMove search", [&](){
+        size_t i = next++ % samples;
+        TranspositionTable table(size_t(1) << 12);
+        ComputerPlayer player(&table);
+        player.book = nullptr;
+        player.useSolvedTable = false;
+        char other = (toMove[i] == 'X') ? 'O' : 'X';
+        sink = sink + player.findBestMove(positions[i], toMove[i], other).row;
+        return player.getStats();
+    }));
+    ComputerPlayer player;
+    results.push_back(runBench("findBestMove", [&](){
+        size_t i = next++ % samples;
+        char other = (toMove[i] == 'X') ? 'O' : 'X';
+        sink = sink + player.findBestMove(positions[i], toMove[i], other).row;
+        return player.getStats();
+    }));
+    std::cout << "{\"benchmarks\": [" << std::endl;
+    for (size_t i = 0; i < results.size(); i++){
+        const BenchResult& result = results[i];
+        std::cout << "  {\"name\": \"" << result.name << "\", \"ops\": " << result.ops << ", \"ns_per_op\": " << result.nsPerOp << ", \"nodes\": " 
+            << result.nodes << ", \"nodes_per_second\": " << result.nodesPerSecond << ", \"allocations_per_op\": " << result.allocationsPerOp
+#ifdef TICTACTOE_STATS
+            << ", \"leaves\": " << result.stats.leaves << ", \"table_hits\": " << result.stats.tableHits << ", \"cutoffs\": " << result.stats.cutoffs 
+            << ", \"max_depth\": " << result.stats.maxDepth << ", \"branching_factor\": " << result.stats.branchingFactor()
+#endif
+            << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    std::cout << "]}" << std::endl;
+};
+/**
+ * @brief Function to check that GameLogReader rejects a block header with a wrong raw size before it allocates the block.
+ * @return bool. True if an intact log is read and a block claiming more than GameLog::blockBytes or games in 0 bytes is rejected.
+ *  The log has two compressed blocks, the header of the first one is changed in the file and the log is opened again by the same reader.
+ */
+bool checkCorruptLog(){
+    char path[] = "/tmp/minimax-log-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || close(fd) != 0){
+        return false;
+    }
+    GameLogWriter writer(path, true);
+    for (int i = 0; i < 30000; i++){
+        GameBoard game(3, 3);
+        for (int k = 0; k < 5; k++){
+            int cell = (i + k * 7) % 9;
+            while (!game.at(cell / 3, cell % 3).getFree()){
+                cell = (cell + 1) % 9;
             }
-            if (board[0][i].getValue() == board[1][i].getValue() && board[1][i].getValue() == board[2][i].getValue() && board[0][i].getValue() == c){
-                if(board[0][i].getFree() == false && board[1][i].getFree() == false && board[2][i].getFree() == false){
-                    return true;
+            game.insert(cell / 3, cell % 3, k % 2 == 0 ? 'X' : 'O');
+        }
+        writer.add(game);
+    }
+    GameLogReader reader;
+    GameLogReader::Statistics statistics;
+    bool ok = writer.close() && reader.open(path) && reader.trailer.blocks > 1 && reader.statistics(statistics) && statistics.games == 30000;
+    size_t rawBytes = sizeof(GameLog::FileHeader) + offsetof(GameLog::BlockHeader, rawBytes);
+    for (uint32_t corrupt : {0xFFFFFFF0u, uint32_t(GameLog::blockBytes + 1), 0u}){
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(std::streamoff(rawBytes));
+        file.write(reinterpret_cast<const char*>(&corrupt), sizeof(corrupt));
+        file.close();
+        ok = ok && file && reader.open(path) && !reader.statistics(statistics);
+    }
+    unlink(path);
+    return ok;
+};
+/**
+ * @brief Function to check every terminal status kernel the CPU can run against BitBoard::isWinner and BitBoard::isDraw, and the 3x3 Tablebase 
+ * against a forward search of every position, and that corrupt game log blocks are rejected.
+ * @return bool. True if all kernels agree with the scalar functions, the tablebase with the search and the log reader rejects the corrupt blocks.
+ *  All pairs of 9 bit masks are checked, also the ones that can not come up in a game. Every kernel runs on the whole array and on parts of it that 
+ * start and end off the SIMD width, so the rest handling is checked too.
+ */
+bool runSelfCheck(){
+    std::vector<BitBoard> boards;
+    std::vector<uint8_t> expected;
+    for (uint16_t x = 0; x <= BitBoard::full; x++){
+        for (uint16_t o = 0; o <= BitBoard::full; o++){
+            BitBoard board;
+            board.x = x;
+            board.o = o;
+            bool xWins = board.isWinner('X');
+            bool oWins = board.isWinner('O');
+            bool draw = !xWins && !oWins && board.isDraw();
+            boards.push_back(board);
+            expected.push_back(uint8_t((xWins ? TerminalKernel::XWins : 0) | (oWins ? TerminalKernel::OWins : 0) | (draw ? TerminalKernel::Draw : 0)));
+        }
+    }
+    bool ok = true;
+    std::vector<uint8_t> status(boards.size());
+    for (const TerminalKernel& kernel : TerminalKernel::available()){
+        size_t mismatches = 0;
+        for (size_t start : {size_t(0), size_t(1), size_t(3), size_t(7)}){
+            for (size_t count : {boards.size() - start, size_t(0), size_t(1), size_t(5), size_t(13), size_t(4099)}){
+                count = std::min(count, boards.size() - start);
+                std::fill(status.begin(), status.end(), uint8_t(0xFF));
+                kernel.run(boards.data() + start, status.data() + start, count);
+                for (size_t i = 0; i < boards.size(); i++){
+                    bool inside = i >= start && i < start + count;
+                    if (status[i] != (inside ? expected[i] : uint8_t(0xFF))){
+                        mismatches++;
+                    }
                 }
             }
         }
-        if (board[0][0].getValue() == board[1][1].getValue() && board[1][1].getValue() == board[2][2].getValue() && board[0][0].getValue() == c){
-            if(board[0][0].getFree() == false && board[1][1].getFree() == false && board[2][2].getFree() == false){
-            return true;
-            }
+        std::cout << "terminal status " << kernel.name << ": " << (mismatches == 0 ? "ok" : "FAILED") << " (" << mismatches << " mismatches)" << std::endl;
+        ok = ok && mismatches == 0;
+    }
+    PositionEvaluator::terminalStatus(boards.data(), status.data(), boards.size(), 0);
+    bool batchOk = std::equal(status.begin(), status.end(), expected.begin());
+    std::cout << "terminal status batch (" << TerminalKernel::best().name << "): " << (batchOk ? "ok" : "FAILED") << std::endl;
+    using Table = Tablebase<3, 3>;
+    std::vector<uint8_t> table = Table::generate(0);
+    std::vector<uint8_t> expected3x3(table.size(), Table::Invalid);
+    auto solve = [&](auto& self, const BitBoard& board) -> uint8_t {
+        uint8_t& value = expected3x3[board.index()];
+        if (value != Table::Invalid){
+            return value;
         }
-        if (board[0][2].getValue() == board[1][1].getValue() && board[1][1].getValue() == board[2][0].getValue() && board[0][2].getValue() == c){
-            if(board[0][2].getFree() == false && board[1][1].getFree() == false && board[2][0].getFree() == false){
-            return true;
-            }
+        char c = board.toMove();
+        int free = 9 - __builtin_popcount(board.x | board.o);
+        if (board.isWinner(c == 'X' ? 'O' : 'X')){
+            return value = Table::entry(Table::Loss, 0);
+        } else if (free == 0){
+            return value = Table::entry(Table::Draw, 0);
         }
-        return false;
-    };
-    /**
-     * @brief Function to check if the game is a draw.
-     * @return bool. True if the game is a draw, false if the game is not a draw.
-     * Checks if the game is a draw by checking if all fields are occupied.
-     */
-    bool isDraw(){
-        for (int i = 0; i < 3; i++){
-            for (int j = 0; j < 3; j++){
-                if (board[i][j].getFree()){
-                    return false;
+        int fastestWin = 100;
+        int slowestLoss = -1;
+        bool draw = false;
+        for (int cell = 0; cell < 9; cell++){
+            if (board.isFree(cell)){
+                BitBoard next = board;
+                next.insert(cell, c);
+                uint8_t child = self(self, next);
+                if (Table::result(child) == Table::Loss){
+                    fastestWin = std::min(fastestWin, Table::distance(child) + 1);
+                } else if (Table::result(child) == Table::Win){
+                    slowestLoss = std::max(slowestLoss, Table::distance(child) + 1);
+                } else {
+                    draw = true;
                 }
             }
         }
-        return true;
+        return value = (fastestWin < 100) ? Table::entry(Table::Win, fastestWin) : draw ? Table::entry(Table::Draw, free) : Table::entry(Table::Loss, slowestLoss);
     };
-
-};
-/**
- * @brief Abstract class to represent a player in the Tic Tac Toe game.
- * @class Player
- *  The player class is an abstract class with a pure virtual function play. This function is implemented by the subclasses HumanPlayer and ComputerPlayer.
- */
-class Player {
-public:
-    Player(){};
-    virtual void play(GameBoard&) = 0;
-
-};
-
-
-/**
- * @brief Class to represent a human player in the Tic Tac Toe game.
- * @class HumanPlayer
- *  The HumanPlayer class is a subclass of the Player class.
- */
-class HumanPlayer : public Player {
-public:
-    /**
-     * @brief Constructor for the HumanPlayer class.
-     */
-    HumanPlayer(){};
-    /**
-     * @brief Function to play a turn in the game. The player is asked to select a row and column to insert their value into. This is always used by Player 1.
-     * @param currentBoard GameBoard. The current game board.
-     * @return void
-     * The player is asked to select a row and column. If the field is free, the value is inserted into the field using the insert method of GameBoard.
-     * If the field is not free, the player is asked to select a new field. This is repeated until the player selects a free field.
-     * This is only for Player 1. Because of my earlier choices to use a boolean, this was necessary. Player 2 uses the playO method.
-     */
-    void play(GameBoard& currentBoard){
-        int row;
-        int column;
-        bool turnSuccess = false;
-        while(!turnSuccess){
-        std::cout << "Select a row: ";
-        std::cin >> row;
-        std::cout << "Select a column: ";
-        std::cin >> column;
-        if(row < 1 || row > 3 || column < 1 || column > 3){
-            std::cout << "Invalid field selection" << std::endl;
-        }
-        else if(!currentBoard.isFree(row-1, column-1)){
-            std::cout << "Invalid field selection" << std::endl;
-        }
-        else {
-            currentBoard.insert(row-1, column-1, 'X');
-            turnSuccess = true;
-        }
+    solve(solve, BitBoard());
+    bool tablebaseOk = table == expected3x3;
+    char path[] = "/tmp/minimax-tablebase-XXXXXX";
+    int fd = mkstemp(path);
+    Table loaded;
+    if (fd < 0 || close(fd) != 0 || !Table::save(path, table) || !loaded.load(path)){
+        tablebaseOk = false;
     }
-    };
-    /**
-     * @brief Function to play a turn in the game. The player is asked to select a row and column to insert their value into. This is always used by Player 2.
-     * @param currentBoard GameBoard. The current game board.
-     * @return void
-     * Same Logic as in the play Method. The only difference is that the value inserted is 'O' instead of 'X'.
-     */
-    void playO(GameBoard& currentBoard){
-        int row;
-        int column;
-        bool turnSuccess = false;
-        while(!turnSuccess){
-        std::cout << "Select a row:";
-        std::cin >> row;
-        std::cout << "Select a column:";
-        std::cin >> column;
-        if(row < 1 || row > 3 || column < 1 || column > 3){
-            std::cout << "Invalid field selection" << std::endl;
-        }
-        else if(!currentBoard.isFree(row-1, column-1)){
-            std::cout << "Invalid field selection" << std::endl;
-        }
-        else {
-            currentBoard.insert(row-1, column-1, 'O');
-            turnSuccess = true;
+    unlink(path);
+    for (uint32_t index = 0; index < table.size() && loaded.isLoaded(); index++){
+        uint32_t x;
+        uint32_t o;
+        Table::decode(index, x, o);
+        MNKBoard<3, 3> board;
+        for (int cell = 0; cell < 9; cell++){
+            if ((x | o) & (1u << cell)){
+                board.insert(cell, (x & (1u << cell)) ? 'X' : 'O');
+            }
+        }
+        int cell;
+        uint8_t value;
+        bool found = loaded.lookup(board, cell, value);
+        if (found != (Table::result(table[index]) != Table::Invalid && Table::distance(table[index]) > 0)){
+            tablebaseOk = false;
         }
     }
-    };
+    std::cout << "tablebase 3x3 (" << std::count_if(table.begin(), table.end(), [](uint8_t value){ return value != Table::Invalid; }) 
+        << " positions): " << (tablebaseOk ? "ok" : "FAILED") << std::endl;
+    bool logOk = checkCorruptLog();
+    std::cout << "game log block headers: " << (logOk ? "ok" : "FAILED") << std::endl;
+    return ok && batchOk && tablebaseOk && logOk;
 };
 /**
- * @brief Class to represent a computer player in the Tic Tac Toe game.
- * @class ComputerPlayer
- *  The ComputerPlayer class is a subclass of the Player class.
+ * @brief Class to serve many games at once over a line protocol, so one process can host the games of many clients.
+ * @class GameServer
+ *  Every line is one command and gets one line as answer. The fields are numbered 0 to 8 (row*3 + column), boards are written as 9 characters 
+ * '.', 'x' and 'o'. The client plays X unless it asks for O.
+ *  "new [x|o]" starts a game and answers "game <id> <move> <state>".
+ *  "move <id> <field>" plays the field for the client and answers "game <id> <move> <state>".
+ *  "best <board>" answers "best <field>" for the player to move, without a game.
+ *  "quit" closes the connection.
+ *  <move> is the field the computer played or '-', <state> is "play" while the game is running and "x", "o" or "draw" once it is over, then the game is 
+ * removed. Invalid commands are answered with "error <reason>".
+ *  With a Unix domain socket every thread runs its own epoll loop. The listening socket is in all loops (EPOLLEXCLUSIVE), the thread that accepts a 
+ * connection keeps it, so the state of a connection is only touched by one thread and needs no lock. The moves come from the ComputerPlayer of the 
+ * thread, which reads the solved table or the opening book that all threads share read-only. It has no transposition table, so if neither is there 
+ * it searches without writing to anything shared. A connection is not read while maxOutput bytes of answers are waiting for the client. SIGINT and 
+ * SIGTERM stop all loops, the server then closes the connections and removes the socket file.
  */
-class ComputerPlayer : public Player {
+class GameServer {
 public:
     /**
-     * @brief Struct to represent a move in the game. This is necessary for the minimax algorithm.
+     * @brief Struct to represent one game of a connection.
      */
-    struct Move {
-        int row;
-        int column;
+    struct ServerGame {
+        BitBoard board;
+        char engine;
     };
-    bool rdm;
     /**
-     * @brief Constructor for the ComputerPlayer class.
-     * @param prdm bool. True if the computer player is a random player, false if the computer uses minimax.
+     * @brief Struct to represent a connection with its buffers and its games.
      */
-    ComputerPlayer(bool prdm){
-        rdm = prdm;
+    struct Connection {
+        int fd;
+        std::string input;
+        std::string output;
+        std::unordered_map<uint32_t, ServerGame> games;
+        uint32_t nextGame;
+        bool closing;
     };
+    static constexpr size_t maxLine = 256;
+    static constexpr size_t maxGames = 1024;
+    static constexpr size_t maxOutput = size_t(1) << 16;
+    static inline int stopEvent = -1;
     /**
-     * @brief Getter for the rdm attribute of the ComputerPlayer class.
-     * @return bool. True if the computer player is a random player, false if the computer uses minimax.
+     * @brief Function to get the state of a game for the answer.
+     * @param board const BitBoard&. The board of the game.
+     * @return const char*. "x" or "o" for the winner, "draw", or "play" if the game is not over.
      */
-    bool getRdm(){
-        return rdm;
+    static const char* state(const BitBoard& board){
+        if (board.isWinner('X')){
+            return "x";
+        }
+        if (board.isWinner('O')){
+            return "o";
+        }
+        return board.isDraw() ? "draw" : "play";
     };
     /**
-     * @brief Function to play a turn in the game. The computer selects a random field to insert their value into.
-     * @param currentBoard GameBoard. The current game board.
-     * @param c char. The value of the computer. To allow for the algorithm to be player 1 and player 2
+     * @brief Function to let the computer move in a game if it is its turn and the game is not over, and write the answer.
+     * @param connection Connection&. The connection of the game.
+     * @param id uint32_t. The game.
+     * @param engine ComputerPlayer&. The computer player of the thread.
      * @return void
-     * The computer selects a random row and column. If the field is free, the value is inserted into the field using the insert method of GameBoard.
-     * If the field is not free, the computer selects a new field. This is repeated until the computer selects a free field.
-     * I have chosen not to print every error message for the computer since it could be a lot of messages if the values are selected randomly.
      */
-    void play(GameBoard& currentBoard){
-        if(rdm){
-        int row;
-        int column;
-        bool turnSuccess = false;
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<int> distr(1,3);
-        while(!turnSuccess){
-        if(rdm){
-            row = distr(gen);
-            column = distr(gen);
-        }
-        if(row < 1 || row > 3 || column < 1 || column > 3){
-            std::cout << "Invalid field selection" << std::endl;
-        }
-        else if(currentBoard.isFree(row-1, column-1)){
-            currentBoard.insert(row-1, column-1, 'O');
-            turnSuccess = true;
-        }
-
-    }
+    static void answerGame(Connection& connection, uint32_t id, ComputerPlayer& engine){
+        ServerGame& game = connection.games[id];
+        char toMove = (__builtin_popcount(game.board.x) == __builtin_popcount(game.board.o)) ? 'X' : 'O';
+        std::string move = "-";
+        if (toMove == game.engine && std::strcmp(state(game.board), "play") == 0){
+            int cell = engine.chooseMove(game.board, game.engine);
+            game.board.insert(cell, game.engine);
+            move = std::to_string(cell);
         }
-        else {
-            playMinimaxO(currentBoard);
+        const char* current = state(game.board);
+        connection.output += "game " + std::to_string(id) + " " + move + " " + current + "\n";
+        if (std::strcmp(current, "play") != 0){
+            connection.games.erase(id);
         }
     };
     /**
-     * @brief Minimax algorithm to find the best score for a move. The algorithm goes through all possible moves and returns a score for the best move possible
-     * from the current game state.
-     * @param currentBoard GameBoard. The current game board.
-     * @param depth int. The depth of the algorithm. Similar to the depth of a tree.
-     * @param isMax bool. True if the computer is maximizing, false if the computer is minimizing. Common in the minimax algorithm.
-     * @param c char. The value of the computer. To allow for the algorithm to be player 1 and player 2
-     * @param other char. The value of the other player. To allow for the algorithm to be player 1 and player 2
-     * @return int The score of the best move.
-     * 
+     * @brief Function to execute one command and append the answer to the output of the connection.
+     * @param connection Connection&. The connection that sent the command.
+     * @param line const std::string&. The command without the line break.
+     * @param engine ComputerPlayer&. The computer player of the thread.
+     * @return void
      */
-    int minimax(GameBoard& currentBoard, int depth, bool isMax, char c, char other){
-        int score = 0;
-       
-        if (currentBoard.isWinner(other)){
-            score = score -10;
-        }
-        else if(currentBoard.isWinner(c)){
-            score= score + 10;
-        }
-        if(score == 10 || score == -10){
-            return score;
-        }
-        if(currentBoard.isDraw()){
-            return 0;
-        }
-        if(isMax){
-            int best = -1000;
-            for (int i = 0; i<3 ; i++){
-                for (int j = 0; j<3; j++){
-                    if(currentBoard.isFree(i,j)){
-                        currentBoard.insert(i,j,c);
-                        best = std::max(best, minimax(currentBoard, depth+1, !isMax,c,other));
-                        currentBoard.refree(i,j);
-                    }
+    static void handleLine(Connection& connection, const std::string& line, ComputerPlayer& engine){
+        char command[16] = {0};
+        char argument[16] = {0};
+        unsigned long id = 0;
+        int cell = -1;
+        if (std::sscanf(line.c_str(), "%15s", command) != 1){
+            connection.output += "error empty command\n";
+        } else if (std::strcmp(command, "new") == 0){
+            int fields = std::sscanf(line.c_str(), "%*s %15s", argument);
+            if (fields == 1 && std::strcmp(argument, "x") != 0 && std::strcmp(argument, "o") != 0){
+                connection.output += "error side has to be x or o\n";
+            } else if (connection.games.size() >= maxGames){
+                connection.output += "error too many games\n";
+            } else {
+                uint32_t game = ++connection.nextGame;
+                connection.games[game].engine = (fields == 1 && argument[0] == 'o') ? 'X' : 'O';
+                answerGame(connection, game, engine);
+            }
+        } else if (std::strcmp(command, "move") == 0){
+            auto game = connection.games.end();
+            if (std::sscanf(line.c_str(), "%*s %lu %d", &id, &cell) == 2 && id <= UINT32_MAX){
+                game = connection.games.find(uint32_t(id));
+            }
+            if (game == connection.games.end()){
+                connection.output += "error unknown game\n";
+            } else {
+                BitBoard& board = game->second.board;
+                char client = (game->second.engine == 'X') ? 'O' : 'X';
+                char toMove = (__builtin_popcount(board.x) == __builtin_popcount(board.o)) ? 'X' : 'O';
+                if (cell < 0 || cell > 8 || !board.isFree(cell)){
+                    connection.output += "error invalid field\n";
+                } else if (toMove != client){
+                    connection.output += "error not your turn\n";
+                } else {
+                    board.insert(cell, client);
+                    answerGame(connection, uint32_t(id), engine);
                 }
             }
-            return best;
-        }
-        else {
-            int best = 1000;
-            for (int i = 0; i<3 ; i++){
-                for (int j = 0; j<3; j++){
-                    if(currentBoard.isFree(i,j)){
-                        currentBoard.insert(i,j,other);
-                        best = std::min(best, minimax(currentBoard, depth+1, !isMax,c,other));
-                        currentBoard.refree(i,j);
-                    }
+        } else if (std::strcmp(command, "best") == 0){
+            BitBoard board;
+            bool valid = std::sscanf(line.c_str(), "%*s %15s", argument) == 1 && std::strlen(argument) == 9;
+            for (int i = 0; valid && i < 9; i++){
+                char field = char(std::tolower(argument[i]));
+                if (field == 'x' || field == 'o'){
+                    board.insert(i, char(std::toupper(field)));
+                } else if (field != '.'){
+                    valid = false;
                 }
             }
-            return best;
+            int difference = __builtin_popcount(board.x) - __builtin_popcount(board.o);
+            if (!valid || difference < 0 || difference > 1){
+                connection.output += "error invalid board\n";
+            } else if (std::strcmp(state(board), "play") != 0){
+                connection.output += "error game is over\n";
+            } else {
+                char toMove = (difference == 0) ? 'X' : 'O';
+                ComputerPlayer::Move move = engine.findBestMove(board, toMove, toMove == 'X' ? 'O' : 'X');
+                connection.output += "best " + std::to_string(move.row * 3 + move.column) + "\n";
+            }
+        } else if (std::strcmp(command, "quit") == 0){
+            connection.closing = true;
+        } else {
+            connection.output += "error unknown command\n";
         }
     };
     /**
-     * @brief Function to find the best move for the computer using the minimax algorithm.
-     * @param currentBoard GameBoard. The current game board.
-     * @param c char. The value of the computer. To allow for the algorithm to be player 1 and player 2
-     * @param other char. The value of the other player. To allow for the algorithm to be player 1 and player 2
-     * @return Move. The best move for the computer.
-     * The function goes through all possible moves and uses minimax to find the best possible move after the current move was made. 
-     * After simulating all possible moves for a single move, the function updates the best move if a better move is found. This is repeated for all possible moves.
-     * The best move is then returned.
+     * @brief Function to execute every complete line in the input of a connection.
+     * @param connection Connection&. The connection.
+     * @param engine ComputerPlayer&. The computer player of the thread.
+     * @return void
+     * A line that is longer than maxLine closes the connection after an error.
      */
-    Move findBestMove(GameBoard& currentBoard,char c,char other){
-        int bestVal = -1000;
-        Move bestMove;
-        bestMove.row = -1;
-        bestMove.column = -1;
-        for (int i = 0; i<3 ; i++){
-            for (int j = 0; j<3; j++){
-                if(currentBoard.isFree(i,j)){
-                    currentBoard.insert(i,j,c);
-                    int moveVal = minimax(currentBoard, 0, false,c,other);
-                    currentBoard.refree(i,j);
-                    if (moveVal > bestVal){
-                        bestMove.row = i;
-                        bestMove.column = j;
-                        bestVal = moveVal;
-                    }
-                }
+    static void handleInput(Connection& connection, ComputerPlayer& engine){
+        size_t start = 0;
+        for (size_t end = connection.input.find('\n'); end != std::string::npos && !connection.closing; end = connection.input.find('\n', start)){
+            std::string line = connection.input.substr(start, end - start);
+            if (!line.empty() && line.back() == '\r'){
+                line.pop_back();
             }
+            handleLine(connection, line, engine);
+            start = end + 1;
+        }
+        connection.input.erase(0, start);
+        if (connection.input.size() > maxLine){
+            connection.output += "error line too long\n";
+            connection.closing = true;
         }
-        return bestMove;
     };
     /**
-     * @brief Function to play a turn in the game. The computer selects the best move using the minimax algorithm.
-     * @param currentBoard GameBoard. The current game board.
+     * @brief Function to serve one client over stdin and stdout.
      * @return void
-     * The computer selects the best move using the findBestMove method.
      */
-    void playMinimaxO(GameBoard& currentBoard){
-        bool turnSuccess = false;
-        Move bestMove = findBestMove(currentBoard,'O','X');
-        while(!turnSuccess){
-        if(currentBoard.isFree(bestMove.row, bestMove.column)){
-            currentBoard.insert(bestMove.row, bestMove.column, 'O');
-            turnSuccess = true;
+    static void serveStdio(){
+        ComputerPlayer engine(nullptr);
+        Connection connection = Connection();
+        std::string line;
+        while (!connection.closing && std::getline(std::cin, line)){
+            connection.input = line + "\n";
+            handleInput(connection, engine);
+            std::cout << connection.output << std::flush;
+            connection.output.clear();
         }
-
-    }
     };
-    void playMinimaxX(GameBoard& currentBoard){
-        bool turnSuccess = false;
-        Move bestMove = findBestMove(currentBoard,'X','O');
-        while(!turnSuccess){
-        if(currentBoard.isFree(bestMove.row, bestMove.column)){
-            currentBoard.insert(bestMove.row, bestMove.column, 'X');
-            turnSuccess = true;
+    /**
+     * @brief Function to write as much of the output of a connection as the socket takes.
+     * @param connection Connection&. The connection.
+     * @return bool. False if the socket failed.
+     */
+    static bool flush(Connection& connection){
+        while (!connection.output.empty()){
+            ssize_t written = send(connection.fd, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+            if (written < 0){
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            connection.output.erase(0, size_t(written));
+        }
+        return true;
+    };
+    /**
+     * @brief Signal handler that stops the socket server.
+     * @param signal int. SIGINT or SIGTERM.
+     * @return void
+     */
+    static void requestStop([[maybe_unused]] int signal){
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(stopEvent, &one, sizeof(one));
+    };
+    /**
+     * @brief Function to create the epoll instance of one thread, with the listening socket and the stop event.
+     * @param listener int. The listening socket.
+     * @return int. The epoll instance, -1 if it could not be created.
+     */
+    static int createLoop(int listener){
+        int events = epoll_create1(EPOLL_CLOEXEC);
+        if (events < 0){
+            return -1;
         }
+        epoll_event event = epoll_event();
+        event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        event.data.fd = listener;
+        epoll_event stop = epoll_event();
+        stop.events = EPOLLIN;
+        stop.data.fd = stopEvent;
+        if (epoll_ctl(events, EPOLL_CTL_ADD, listener, &event) < 0 || epoll_ctl(events, EPOLL_CTL_ADD, stopEvent, &stop) < 0){
+            close(events);
+            return -1;
         }
-    };  
-};
-/**
- * @brief Class to handle a running game.
- * @class Game
- */
-class Game {
-    public:
+        return events;
+    };
     /**
-     * @brief Starting a Human vs Human game.
-     * @param player1 HumanPlayer*. The first player.
-     * @param player2 HumanPlayer*. The second player.
+     * @brief Function run by every thread of the socket server. Accepts connections and serves the connections it accepted until the server is stopped.
+     * @param listener int. The listening socket.
+     * @param events int. The epoll instance of the thread, from createLoop. It is closed at the end.
      * @return void
      */
-    void startHvH(HumanPlayer* player1, HumanPlayer* player2){
-        GameBoard game = GameBoard();
-
-        game.printBoard();
-        std::cout << "Player 1: X" << std::endl;
-        std::cout << "Player 2: O" << std::endl;
+    static void eventLoop(int listener, int events){
+        epoll_event event = epoll_event();
+        ComputerPlayer engine(nullptr);
+        std::unordered_map<int, Connection> connections;
+        epoll_event ready[64];
+        char buffer[4096];
         bool running = true;
         while (running){
-            std::cout << "Player 1's turn" << std::endl;
-            player1->play(game);
-            game.printBoard();
-            if (game.isWinner('X')){
-                std::cout << "Winner is: Player 1" << std::endl;
-                running = false;
-                break;
-            }
-            if(game.isDraw()){
-                std::cout << "A draw!" << std::endl;
-                running = false;
+            int count = epoll_wait(events, ready, 64, -1);
+            if (count < 0 && errno != EINTR){
                 break;
             }
-            std::cout << "Player 2's turn" << std::endl;
-            player2->playO(game);
-            game.printBoard();
-            if (game.isWinner('O')){
-                std::cout << "Winner is: Player 2" << std::endl;
-                running = false;
-                break;
+            for (int i = 0; i < count; i++){
+                int fd = ready[i].data.fd;
+                if (fd == stopEvent){
+                    running = false;
+                    continue;
+                }
+                if (fd == listener){
+                    int client;
+                    while ((client = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0){
+                        Connection& connection = connections[client];
+                        connection = Connection();
+                        connection.fd = client;
+                        event.events = EPOLLIN | EPOLLRDHUP;
+                        event.data.fd = client;
+                        if (epoll_ctl(events, EPOLL_CTL_ADD, client, &event) < 0){
+                            close(client);
+                            connections.erase(client);
+                        }
+                    }
+                    continue;
+                }
+                Connection& connection = connections[fd];
+                bool open = true;
+                if (ready[i].events & EPOLLIN){
+                    ssize_t received = 1;
+                    while (connection.output.size() < maxOutput && (received = recv(fd, buffer, sizeof(buffer), 0)) > 0){
+                        connection.input.append(buffer, size_t(received));
+                        handleInput(connection, engine);
+                    }
+                    if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)){
+                        open = false;
+                    }
+                }
+                if (ready[i].events & (EPOLLHUP | EPOLLERR)){
+                    open = false;
+                }
+                open = flush(connection) && open && !(connection.closing && connection.output.empty());
+                if (!open){
+                    epoll_ctl(events, EPOLL_CTL_DEL, fd, nullptr);
+                    close(fd);
+                    connections.erase(fd);
+                    continue;
+                }
+                event.events = EPOLLRDHUP | (connection.output.size() < maxOutput ? uint32_t(EPOLLIN) : 0u) 
+                    | (connection.output.empty() ? 0u : uint32_t(EPOLLOUT));
+                event.data.fd = fd;
+                if (epoll_ctl(events, EPOLL_CTL_MOD, fd, &event) < 0){
+                    close(fd);
+                    connections.erase(fd);
+                }
             }
-            
         }
+        for (const auto& connection : connections){
+            close(connection.first);
+        }
+        close(events);
     };
     /**
-     * @brief Starting a Human vs Computer game.
-     * @param player1 HumanPlayer*. The first player.
-     * @param player2 ComputerPlayer*. The second player.
-     * @return void
+     * @brief Function to serve clients on a Unix domain socket until the process gets SIGINT or SIGTERM.
+     * @param path const char*. The path of the socket. An old socket file at the path is removed.
+     * @param threads int. The number of threads, 0 for one per core.
+     * @return bool. False if the socket or the event loops could not be created.
      */
-    void startHvC(HumanPlayer* player1, ComputerPlayer* player2){
-        GameBoard game = GameBoard();
-
-        game.printBoard();
-        std::cout << "Player 1: X" << std::endl;
-        std::cout << "Player 2: O" << std::endl;
-        bool running = true;
-        while (running){
-            std::cout << "Player 1's turn" << std::endl;
-            player1->play(game);
-            game.printBoard();
-            if (game.isWinner('X')){
-                std::cout << "Winner is: Player 1" << std::endl;
-                running = false;
-                break;
+    static bool serveSocket(const char* path, int threads){
+        sockaddr_un address = sockaddr_un();
+        address.sun_family = AF_UNIX;
+        if (std::strlen(path) >= sizeof(address.sun_path)){
+            return false;
+        }
+        std::strcpy(address.sun_path, path);
+        int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        unlink(path);
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0){
+            if (listener >= 0){
+                close(listener);
             }
-            if(game.isDraw()){
-                std::cout << "A draw!" << std::endl;
-                running = false;
+            return false;
+        }
+        if (threads <= 0){
+            threads = std::max(1, int(std::thread::hardware_concurrency()));
+        }
+        stopEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        std::vector<int> loops;
+        for (int i = 0; i < threads && stopEvent >= 0; i++){
+            int events = createLoop(listener);
+            if (events < 0){
                 break;
             }
-            std::cout << "Player 2's turn" << std::endl;
-            player2->play(game);
-            game.printBoard();
-            if (game.isWinner('O')){
-                std::cout << "Winner is: Player 2" << std::endl;
-                running = false;
-                break;
+            loops.push_back(events);
+        }
+        if (int(loops.size()) < threads){
+            for (int events : loops){
+                close(events);
             }
-            
+            if (stopEvent >= 0){
+                close(stopEvent);
+            }
+            close(listener);
+            unlink(path);
+            return false;
         }
+        struct sigaction action = {};
+        action.sa_handler = requestStop;
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        std::vector<std::thread> pool;
+        for (int i = 1; i < threads; i++){
+            pool.emplace_back(eventLoop, listener, loops[i]);
+        }
+        eventLoop(listener, loops[0]);
+        for (std::thread& thread : pool){
+            thread.join();
+        }
+        signal(SIGINT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+        close(stopEvent);
+        close(listener);
+        unlink(path);
+        return true;
     };
-    /**
-     * @brief Starting a Computer vs Computer game.
-     * @param player1 ComputerPlayer*. The first player.
-     * @param player2 ComputerPlayer*. The second player.
-     * @return void
-     */
-    void startCvC(ComputerPlayer* player1, ComputerPlayer* player2){
-        GameBoard game = GameBoard();
-        game.printBoard();
-        std::cout << "Player 1: X" << std::endl;
-        std::cout << "Player 2: O" << std::endl;
-        bool running = true;
-        while (running){
-            std::cout << "Player 1's turn" << std::endl;
-            player1->playMinimaxX(game);
-            game.printBoard();
-            if (game.isWinner('X')){
-                std::cout << "Winner is: Player 1" << std::endl;
-                running = false;
-                break;
+};
+/**
+ * @brief Function to connect to a game server.
+ * @param path const char*. The path of the socket.
+ * @return int. The socket, -1 if the connection failed.
+ */
+int connectToServer(const char* path){
+    sockaddr_un address = sockaddr_un();
+    address.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(address.sun_path)){
+        return -1;
+    }
+    std::strcpy(address.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0){
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+};
+/**
+ * @brief Function to read one line from a socket. Reads one byte at a time, which is fine for the short answers of the server.
+ * @param fd int. The socket.
+ * @param line std::string&. Set to the line without the line break.
+ * @return bool. False if the connection was closed.
+ */
+bool readServerLine(int fd, std::string& line){
+    line.clear();
+    char c;
+    while (recv(fd, &c, 1, 0) == 1){
+        if (c == '\n'){
+            return true;
+        }
+        line += c;
+    }
+    return false;
+};
+/**
+ * @brief Stub client for the game server. Opens many connections at once and plays random games on all of them, so the server can be tested locally.
+ * @param path const char*. The path of the socket.
+ * @param connections int. The number of connections.
+ * @param games int. The number of games on every connection.
+ * @return bool. False if a connection failed, the server answered with an error or the computer lost a game.
+ * All connections send their command first and then all answers are read, so the server has many requests in flight at the same time. The client 
+ * plays X on even connections and O on odd ones.
+ */
+bool runStubClient(const char* path, int connections, int games){
+    std::vector<int> fds;
+    std::vector<BitBoard> boards(connections);
+    std::vector<int> played(connections, 0);
+    std::vector<uint32_t> ids(connections, 0);
+    FastRandom rng(1);
+    for (int i = 0; i < connections; i++){
+        int fd = connectToServer(path);
+        if (fd < 0){
+            std::cout << "Could not connect to " << path << std::endl;
+            for (int open : fds){
+                close(open);
             }
-            if(game.isDraw()){
-                std::cout << "A draw!" << std::endl;
-                running = false;
-                break;
+            return false;
+        }
+        fds.push_back(fd);
+    }
+    uint64_t requests = 0;
+    uint64_t results[3] = {0, 0, 0};
+    bool ok = true;
+    auto start = std::chrono::steady_clock::now();
+    for (int active = connections; active > 0 && ok;){
+        for (int i = 0; i < connections; i++){
+            if (played[i] >= games){
+                continue;
+            }
+            std::string command;
+            if (ids[i] == 0){
+                boards[i] = BitBoard();
+                command = (i % 2 == 0) ? "new x\n" : "new o\n";
+            } else {
+                command = "move " + std::to_string(ids[i]) + " " + std::to_string(rng.pick(boards[i].freeCells())) + "\n";
+                boards[i].insert(std::atoi(command.c_str() + command.rfind(' ') + 1), (i % 2 == 0) ? 'X' : 'O');
+            }
+            ok = ok && send(fds[i], command.data(), command.size(), MSG_NOSIGNAL) == ssize_t(command.size());
+            requests++;
+        }
+        for (int i = 0; i < connections && ok; i++){
+            if (played[i] >= games){
+                continue;
             }
-            std::cout << "Player 2's turn" << std::endl;
-            player2->play(game);
-            game.printBoard();
-            if (game.isWinner('O')){
-                std::cout << "Winner is: Player 2" << std::endl;
-                running = false;
+            std::string line;
+            char move[8] = {0};
+            char status[8] = {0};
+            unsigned long id = 0;
+            if (!readServerLine(fds[i], line) || std::sscanf(line.c_str(), "game %lu %7s %7s", &id, move, status) != 3){
+                std::cout << "Unexpected answer: " << line << std::endl;
+                ok = false;
                 break;
             }
-            
+            ids[i] = uint32_t(id);
+            if (move[0] != '-'){
+                boards[i].insert(std::atoi(move), (i % 2 == 0) ? 'O' : 'X');
+            }
+            if (std::strcmp(status, "play") != 0){
+                char client = (i % 2 == 0) ? 'x' : 'o';
+                results[status[0] == client ? 0 : (std::strcmp(status, "draw") == 0 ? 1 : 2)]++;
+                ids[i] = 0;
+                if (++played[i] == games){
+                    active--;
+                }
+            }
         }
-    };
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (int fd : fds){
+        close(fd);
+    }
+    uint64_t total = results[0] + results[1] + results[2];
+    std::cout << total << " games on " << connections << " connections in " << seconds << " s, " << double(requests) / seconds << " requests/s" << std::endl;
+    std::cout << "Client wins: " << results[0] << ", draws: " << results[1] << ", computer wins: " << results[2] << std::endl;
+    return ok && results[0] == 0;
+};
+/**
+ * @brief Function to measure how the parallel search scales. Searches the empty board to a fixed depth with 1, 2, 4, ... threads up to one per 
+ * core and prints the time, the nodes, the speedup over one thread and if the same move was found.
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ * @param depth int. The number of moves to look ahead.
+ * @return void
+ */
+template<int N, int K>
+void measureSpeedup(int depth){
+    int maxThreads = std::max(1, int(std::thread::hardware_concurrency()));
+    std::cout << N << "x" << N << ", " << K << " in a row, depth " << depth << std::endl;
+    double serialTime = 0;
+    int serialMove = -1;
+    for (int threads = 1; ; threads = std::min(threads * 2, maxThreads)){
+        ParallelMNKSearch<N, K> search(threads);
+        MNKBoard<N, K> board;
+        auto start = std::chrono::steady_clock::now();
+        int cell = search.findBestMove(board, SearchLimits(0, 0, depth));
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1){
+            serialTime = time;
+            serialMove = cell;
+        }
+        std::cout << "  " << threads << " threads: " << time << " s, " << search.totalNodes() << " nodes, speedup " << serialTime / time
+            << (cell == serialMove ? ", same move" : ", different move") << std::endl;
+        if (threads == maxThreads){
+            break;
+        }
+    }
+};
+/**
+ * @brief Function to solve an m,n,k game with retrograde analysis, print a summary and write the tablebase file.
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ * @param path const char*. The path of the file.
+ * @param threads int. The number of threads, 0 for one per core.
+ * @return bool. True if the file was written.
+ */
+template<int N, int K>
+bool writeTablebase(const char* path, int threads){
+    using Table = Tablebase<N, K>;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> table = Table::generate(threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t results[4] = {0, 0, 0, 0};
+    for (uint8_t value : table){
+        results[Table::result(value)]++;
+    }
+    std::cout << N << "x" << N << ", " << K << " in a row: " << results[Table::Win] + results[Table::Loss] + results[Table::Draw] << " positions in " 
+        << seconds << " s, " << results[Table::Win] << " won, " << results[Table::Loss] << " lost and " << results[Table::Draw] 
+        << " drawn for the player to move" << std::endl;
+    const char* names[4] = {"invalid", "X wins", "O wins", "draw"};
+    std::cout << "Empty board: " << names[Table::result(table[0])] << " in " << Table::distance(table[0]) << " moves" << std::endl;
+    return Table::save(path, table);
+};
+/**
+ * @brief Function to find a file in the directory of the executable, where make puts the opening book and the tablebase.
+ * @param name const char*. The name of the file.
+ * @return std::string. The path of the file next to the executable, the name itself if the executable can not be found.
+ */
+std::string besideExecutable(const char* name){
+    char path[4096];
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (length <= 0){
+        return name;
+    }
+    std::string directory(path, size_t(length));
+    return directory.substr(0, directory.rfind('/') + 1) + name;
 };
 /**
  * @brief Main function to run the program.
+ * @param argc int. The number of command line arguments.
+ * @param argv char**. The command line arguments. "--generate-book <file>" writes the opening book and exits, "--book <file>" loads the book from 
+ * another file than minimax.book next to the executable, "--threads <n>" sets the number of threads of the computer on larger boards (0 for one per core) and "--speedup" 
+ * measures how much faster the search gets with more threads and exits. "--selfplay <games> <agent> <agent>" plays games between two agents 
+ * (see AgentSpec) without the console, prints the results and exits, "--seed <n>" sets its seed. The self-play uses one thread per core unless 
+ * --threads is given. "--bench" runs the benchmarks of the engine, prints them as JSON and exits. "--stats" prints the statistics of every 
+ * search of the computer. "--serve [socket]" serves games over the line protocol of GameServer, on a Unix domain socket or on stdin and stdout, 
+ * "--client <socket> <connections> <games>" plays random games against a server to test it. "--positions <file> <count>" writes random positions 
+ * and "--evaluate <in> <out>" scores a position file with PositionEvaluator. "--log <file>" writes the games on the 3x3 board and the self-play 
+ * games to a compressed game log, "--log-raw <file>" to an uncompressed one, "--log-stats <file>" prints the statistics of a game log and exits. 
+ * "--replay <file>" prints the games of a game log. "--final-board" only prints the board at the end of Computer vs Computer games and replayed 
+ * games, "--quiet" only the results. "--self-check" checks the terminal status kernels, the tablebase generator and the game log reader and exits. 
+ * "--generate-tablebase <n> <file>" solves the n x n board (3 or 4, n in a row) with a Tablebase and writes it, "--tablebase <file>" loads the 4x4 
+ * tablebase from another file than minimax-4x4.tablebase next to the executable. The computer ponders (searches while the human thinks) unless "--no-ponder" is given, 
+ * "--deadline <seconds>" cuts off every move of the computer (alpha-beta and MCTS, on every board) after that time. std::cout is only synchronized with stdio 
+ * when stdin and stdout are terminals.
  * @return int. 0 if the program runs successfully, 1 if the program fails.
  * This method is always running in a loop. The user is asked to choose what game mode they want to play. 
- * Once a game finishes the loop is started over again.
+ * Once a game finishes the loop is started over again. The opening book is loaded before, if it can not be loaded the computer uses the search.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    std::string bookPath = besideExecutable("minimax.book");
+    int threads = -1;
+    uint64_t seed = 1;
+    bool showStats = false;
+    bool ponder = true;
+    double deadline = 0;
+    const char* servePath = nullptr;
+    const char* evaluate[2] = {nullptr, nullptr};
+    bool writePositionFile = false;
+    bool serve = false;
+    const char* selfPlay[3] = {nullptr, nullptr, nullptr};
+    const char* logPath = nullptr;
+    bool compressLog = true;
+    const char* replayPath = nullptr;
+    Game::Output output = Game::Full;
+    std::string tablebasePath = besideExecutable("minimax-4x4.tablebase");
+    const char* tablebaseOut = nullptr;
+    int tablebaseSize = 0;
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)){
+        std::ios::sync_with_stdio(false);
+    }
+    for (int i = 1; i < argc; i++){
+        if (std::strcmp(argv[i], "--generate-book") == 0 && i + 1 < argc){
+            if (!generateOpeningBook(argv[i+1])){
+                std::cout << "Could not write the opening book to " << argv[i+1] << std::endl;
+                return 1;
+            }
+            return 0;
+        } else if (std::strcmp(argv[i], "--generate-tablebase") == 0 && i + 2 < argc){
+            tablebaseSize = std::atoi(argv[++i]);
+            tablebaseOut = argv[++i];
+        } else if (std::strcmp(argv[i], "--tablebase") == 0 && i + 1 < argc){
+            tablebasePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--book") == 0 && i + 1 < argc){
+            bookPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc){
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc){
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--selfplay") == 0 && i + 3 < argc){
+            selfPlay[0] = argv[++i];
+            selfPlay[1] = argv[++i];
+            selfPlay[2] = argv[++i];
+        } else if (std::strcmp(argv[i], "--serve") == 0){
+            serve = true;
+            if (i + 1 < argc && argv[i+1][0] != '-'){
+                servePath = argv[++i];
+            }
+        } else if (std::strcmp(argv[i], "--client") == 0 && i + 3 < argc){
+            return runStubClient(argv[i+1], std::atoi(argv[i+2]), std::atoi(argv[i+3])) ? 0 : 1;
+        } else if (std::strcmp(argv[i], "--positions") == 0 && i + 2 < argc){
+            evaluate[0] = argv[++i];
+            evaluate[1] = argv[++i];
+            writePositionFile = true;
+        } else if (std::strcmp(argv[i], "--evaluate") == 0 && i + 2 < argc){
+            evaluate[0] = argv[++i];
+            evaluate[1] = argv[++i];
+        } else if ((std::strcmp(argv[i], "--log") == 0 || std::strcmp(argv[i], "--log-raw") == 0) && i + 1 < argc){
+            compressLog = std::strcmp(argv[i], "--log") == 0;
+            logPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc){
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--final-board") == 0){
+            output = Game::FinalBoard;
+        } else if (std::strcmp(argv[i], "--quiet") == 0){
+            output = Game::Quiet;
+        } else if (std::strcmp(argv[i], "--log-stats") == 0 && i + 1 < argc){
+            return printLogStatistics(argv[i+1]) ? 0 : 1;
+        } else if (std::strcmp(argv[i], "--stats") == 0){
+            showStats = true;
+        } else if (std::strcmp(argv[i], "--no-ponder") == 0){
+            ponder = false;
+        } else if (std::strcmp(argv[i], "--deadline") == 0 && i + 1 < argc){
+            deadline = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--bench") == 0){
+            runBenchmarks();
+            return 0;
+        } else if (std::strcmp(argv[i], "--self-check") == 0){
+            return runSelfCheck() ? 0 : 1;
+        } else if (std::strcmp(argv[i], "--speedup") == 0){
+            measureSpeedup<5, 4>(8);
+            measureSpeedup<15, 5>(6);
+            return 0;
+        } else {
+            std::cout << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (replayPath){
+        return replayLog(replayPath, output) ? 0 : 1;
+    }
+    if (tablebaseOut){
+        bool written = false;
+        if (tablebaseSize == 3){
+            written = writeTablebase<3, 3>(tablebaseOut, std::max(threads, 0));
+        } else if (tablebaseSize == 4){
+            written = writeTablebase<4, 4>(tablebaseOut, std::max(threads, 0));
+        } else {
+            std::cout << "Tablebases are only possible for 3x3 and 4x4" << std::endl;
+            return 1;
+        }
+        if (!written){
+            std::cout << "Could not write the tablebase to " << tablebaseOut << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    OpeningBook::shared().load(bookPath.c_str());
+    Tablebase<4, 4>::shared().load(tablebasePath.c_str());
+    if (writePositionFile){
+        if (!PositionEvaluator::writePositions(evaluate[0], std::strtoull(evaluate[1], nullptr, 10), seed)){
+            std::cout << "Could not write " << evaluate[0] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (evaluate[0]){
+        auto start = std::chrono::steady_clock::now();
+        uint64_t count = PositionEvaluator::evaluateFile(evaluate[0], evaluate[1], std::max(threads, 0));
+        if (count == 0){
+            std::cout << "Could not evaluate " << evaluate[0] << std::endl;
+            return 1;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << count << " positions in " << seconds << " s, " << double(count) / seconds << " positions/s" << std::endl;
+        return 0;
+    }
+    if (serve){
+        if (!servePath){
+            GameServer::serveStdio();
+            return 0;
+        }
+        if (!GameServer::serveSocket(servePath, std::max(threads, 0))){
+            std::cout << "Could not open the socket " << servePath << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    std::unique_ptr<GameLogWriter> log;
+    if (logPath){
+        log.reset(new GameLogWriter(logPath, compressLog));
+        if (!log->good()){
+            std::cout << "Could not write the game log " << logPath << std::endl;
+            return 1;
+        }
+    }
+    if (selfPlay[0]){
+        bool played = printSelfPlay(selfPlay[1], selfPlay[2], std::strtoull(selfPlay[0], nullptr, 10), std::max(threads, 0), seed, log.get());
+        if (log && !log->close()){
+            std::cout << "Could not write the game log " << logPath << std::endl;
+            return 1;
+        }
+        return played ? 0 : 1;
+    }
+    if (threads < 0){
+        threads = 1;
+    }
     bool programRunning = true;
     while(programRunning){
     std::cout << "Choose your game mode." << std::endl;
@@ -592,7 +1236,9 @@ int main() {
     std::cout << "(2) Human vs Computer (Minimax)" << std::endl;
     std::cout << "(3) Human vs Computer (Random)" << std::endl;
     std::cout << "(4) Computer (Minimax) vs Computer (Minimax)" << std::endl;
-    std::cout << "(5) Exit Program" << std::endl;
+    std::cout << "(5) Larger board (m,n,k game)" << std::endl;
+    std::cout << "(6) Human vs Computer (MCTS)" << std::endl;
+    std::cout << "(7) Exit Program" << std::endl;
     int choice;
     std::cin >> choice;
     if(std::cin.fail()){
@@ -602,37 +1248,63 @@ int main() {
     switch (choice){
         case 1:
         {
-            Game CurrentGame = Game();
+            Game CurrentGame = Game(3, 3, nullptr, log.get());
             HumanPlayer player1 = HumanPlayer();
             HumanPlayer player2 = HumanPlayer();
-            CurrentGame.startHvH(&player1, &player2);
+            CurrentGame.start(&player1, &player2);
             break;
         }
         case 2:
         {
-            Game CurrentGame = Game();
+            Game CurrentGame = Game(3, 3, nullptr, log.get());
             HumanPlayer player1 = HumanPlayer();
-            ComputerPlayer player2 = ComputerPlayer(false);
-            CurrentGame.startHvC(&player1, &player2);
+            AgentPlayer<ComputerPlayer> player2;
+            player2.printStats = showStats;
+            player2.deadline = deadline;
+            CurrentGame.start(&player1, &player2);
             break;
             }
         case 3:
         {
-            Game CurrentGame = Game();
+            Game CurrentGame = Game(3, 3, nullptr, log.get());
             HumanPlayer player1 = HumanPlayer();
-            ComputerPlayer player2 = ComputerPlayer(true);
-            CurrentGame.startHvC(&player1, &player2);
+            AgentPlayer<RandomAgent> player2;
+            CurrentGame.start(&player1, &player2);
             break;
             }
         case 4:
         {
-            Game CurrentGame = Game();
-            ComputerPlayer player1 = ComputerPlayer(false);
-            ComputerPlayer player2 = ComputerPlayer(false);
-            CurrentGame.startCvC(&player1, &player2);
+            Game CurrentGame = Game(3, 3, nullptr, log.get());
+            CurrentGame.output = output;
+            AgentPlayer<ComputerPlayer> player1;
+            AgentPlayer<ComputerPlayer> player2;
+            player1.printStats = showStats;
+            player2.printStats = showStats;
+            player1.deadline = deadline;
+            player2.deadline = deadline;
+            CurrentGame.start(&player1, &player2);
             break;
             }
         case 5:
+        {
+            if (!chooseLargerBoard(threads, showStats, ponder, deadline)){
+                std::cout << "Invalid input. Exiting program." << std::endl;
+                return 1;
+            }
+            break;
+            }
+        case 6:
+        {
+            Game CurrentGame = Game(3, 3, nullptr, log.get());
+            HumanPlayer player1 = HumanPlayer();
+            AgentPlayer<MCTSAgent> player2(SearchLimits(0.5), threads);
+            player2.printStats = showStats;
+            player2.agent.ponderEnabled = ponder;
+            player2.deadline = deadline;
+            CurrentGame.start(&player1, &player2);
+            break;
+            }
+        case 7:
         {
             std::cout << "Exiting program." << std::endl;
             return 0;
@@ -646,4 +1318,4 @@ int main() {
 
     }
     return 0;
-};
\ No newline at end of file
+};
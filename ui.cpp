@@ -0,0 +1,144 @@
+#include "ui.h"
+bool replayLog(const char* path, Game::Output output){
+    GameLogReader reader;
+    if (!reader.open(path)){
+        std::cout << "Could not read the game log " << path << std::endl;
+        return false;
+    }
+    std::vector<char> buffer;
+    buffer.reserve(size_t(1) << 20);
+    GameBoard board;
+    uint64_t number = 0;
+    auto printFrame = [&](){
+        size_t used = buffer.size();
+        buffer.resize(used + board.frameBytes());
+        buffer.resize(used + board.render(buffer.data() + used));
+    };
+    bool complete = reader.forEachGame([&](const uint8_t* moves, int length, char result){
+        char line[64];
+        buffer.insert(buffer.end(), line, line + std::snprintf(line, sizeof(line), "Game %llu: %s\n", (unsigned long long)++number, 
+            result == 'D' ? "draw" : (result == 'X' ? "X wins" : "O wins")));
+        if (output != Game::Quiet){
+            while (board.undo()){
+            }
+            for (int i = 0; i < length; i++){
+                board.insert(moves[i] / 3, moves[i] % 3, (i % 2 == 0) ? 'X' : 'O');
+                if (output == Game::Full){
+                    printFrame();
+                }
+            }
+            if (output == Game::FinalBoard){
+                printFrame();
+            }
+        }
+        if (buffer.size() >= (size_t(1) << 20) - 4096){
+            std::cout.write(buffer.data(), std::streamsize(buffer.size()));
+            buffer.clear();
+        }
+    });
+    std::cout.write(buffer.data(), std::streamsize(buffer.size()));
+    if (!complete){
+        std::cout << "The game log " << path << " is corrupt after game " << number << "\n";
+    }
+    std::cout.flush();
+    return complete;
+};
+bool printLogStatistics(const char* path){
+    GameLogReader reader;
+    GameLogReader::Statistics statistics;
+    auto start = std::chrono::steady_clock::now();
+    if (!reader.open(path) || !reader.statistics(statistics)){
+        std::cout << "Could not read the game log " << path << std::endl;
+        return false;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double percent = statistics.games ? 100.0 / double(statistics.games) : 0.0;
+    std::cout << statistics.games << " games in " << reader.size << " bytes, read in " << seconds << " s" << std::endl;
+    std::cout << "X wins: " << double(statistics.results[0]) * percent << "%, O wins: " << double(statistics.results[1]) * percent << "%, draws: " 
+        << double(statistics.results[2]) * percent << "%" << std::endl;
+    std::cout << "Moves per game:";
+    for (int length = 0; length <= 9; length++){
+        if (statistics.lengths[length]){
+            std::cout << " " << length << ": " << double(statistics.lengths[length]) * percent << "%";
+        }
+    }
+    std::cout << std::endl << "First move:";
+    for (int cell = 0; cell < 9; cell++){
+        std::cout << " " << cell << ": " << double(statistics.firstMoves[cell]) * percent << "%";
+    }
+    int order[81];
+    for (int i = 0; i < 81; i++){
+        order[i] = i;
+    }
+    std::sort(order, order + 81, [&](int a, int b){ return statistics.openings[a] > statistics.openings[b]; });
+    std::cout << std::endl << "Most played openings:";
+    for (int i = 0; i < 5 && statistics.openings[order[i]]; i++){
+        std::cout << " " << order[i] / 9 << "," << order[i] % 9 << ": " << double(statistics.openings[order[i]]) * percent << "%";
+    }
+    std::cout << std::endl;
+    return true;
+};
+/**
+ * @brief Function to start a game on a larger board.
+ * @tparam N int. The number of rows and columns.
+ * @tparam K int. The number of fields in a row needed to win.
+ * @param opponent int. 1 if Player 2 is a human, 2 for the computer with the alpha-beta search and 3 for the computer with MCTS.
+ * @param threads int. The number of threads the computer searches with.
+ * @param stats bool. True to print the statistics of every search.
+ * @param ponder bool. True to let the computer search while the human thinks.
+ * @param deadline double. The hard limit for every move of the computer in seconds, 0 for none.
+ * @return void
+ */
+template<int N, int K>
+void startLargerBoard(int opponent, int threads, bool stats, bool ponder, double deadline){
+    Game CurrentGame = Game(N, K);
+    HumanPlayer player1 = HumanPlayer();
+    if (opponent == 2){
+        MNKComputerPlayer<N, K> player2(SearchLimits(1.0), threads);
+        player2.printStats = stats;
+        player2.ponderEnabled = ponder;
+        player2.deadline = deadline;
+        CurrentGame.start(&player1, &player2);
+    } else if (opponent == 3){
+        MNKMCTSPlayer<N, K> player2(SearchLimits(1.0), threads);
+        player2.printStats = stats;
+        player2.ponderEnabled = ponder;
+        player2.deadline = deadline;
+        CurrentGame.start(&player1, &player2);
+    } else {
+        HumanPlayer player2 = HumanPlayer();
+        CurrentGame.start(&player1, &player2);
+    }
+};
+bool chooseLargerBoard(int threads, bool stats, bool ponder, double deadline){
+    std::cout << "Choose the board." << std::endl;
+    std::cout << "(1) 4x4, 4 in a row" << std::endl;
+    std::cout << "(2) 5x5, 4 in a row" << std::endl;
+    std::cout << "(3) 15x15, 5 in a row (Gomoku)" << std::endl;
+    int board;
+    std::cin >> board;
+    if (std::cin.fail() || board < 1 || board > 3){
+        return false;
+    }
+    std::cout << "Choose the opponent." << std::endl;
+    std::cout << "(1) Human" << std::endl;
+    std::cout << "(2) Computer (Minimax)" << std::endl;
+    std::cout << "(3) Computer (MCTS)" << std::endl;
+    int opponent;
+    std::cin >> opponent;
+    if (std::cin.fail() || opponent < 1 || opponent > 3){
+        return false;
+    }
+    switch (board){
+        case 1:
+            startLargerBoard<4, 4>(opponent, threads, stats, ponder, deadline);
+            break;
+        case 2:
+            startLargerBoard<5, 4>(opponent, threads, stats, ponder, deadline);
+            break;
+        default:
+            startLargerBoard<15, 5>(opponent, threads, stats, ponder, deadline);
+            break;
+    }
+    return true;
+};
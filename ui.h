@@ -0,0 +1,152 @@
+#ifndef TICTACTOE_UI_H
+#define TICTACTOE_UI_H
+#include "engine.h"
+/**
+ * @brief Class to represent a human player in the Tic Tac Toe game.
+ * @class HumanPlayer
+ *  The HumanPlayer class is a subclass of the Player class.
+ */
+class HumanPlayer : public Player {
+public:
+    /**
+     * @brief Constructor for the HumanPlayer class.
+     */
+    HumanPlayer(){};
+    /**
+     * @brief Function to choose a field. The player is asked to select a row and column.
+     * @param currentBoard GameBoard&. The current game board.
+     * @param c char. The symbol of the player, not needed since the player knows it.
+     * @return int. The field (row*size + column).
+     * If the field is not free, the player is asked to select a new field. This is repeated until the player selects a free field.
+     */
+    int chooseMove(GameBoard& currentBoard, [[maybe_unused]] char c){
+        int row;
+        int column;
+        while(true){
+        std::cout << "Select a row: ";
+        std::cin >> row;
+        std::cout << "Select a column: ";
+        std::cin >> column;
+        if(row < 1 || row > currentBoard.size || column < 1 || column > currentBoard.size){
+            std::cout << "Invalid field selection" << std::endl;
+        }
+        else if(!currentBoard.isFree(row-1, column-1)){
+            std::cout << "Invalid field selection" << std::endl;
+        }
+        else {
+            return (row-1) * currentBoard.size + column-1;
+        }
+    }
+    };
+};
+/**
+ * @brief Class to handle a running game.
+ * @class Game
+ */
+class Game {
+    public:
+    /**
+     * @brief What a game prints. Full prints the board after every move, FinalBoard only the board at the end and Quiet only the result.
+     */
+    enum Output { Full, FinalBoard, Quiet };
+    int size;
+    int winLength;
+    GameRecordArena* records;
+    GameLogWriter* log;
+    Output output;
+    /**
+     * @brief Constructor for the Game class.
+     * @param psize int. The number of rows and columns of the board.
+     * @param pwinLength int. The number of fields in a row needed to win.
+     * @param precords GameRecordArena*. Where the finished games are recorded, nullptr to not record them.
+     * @param plog GameLogWriter*. The game log the finished games are written to, nullptr to not write them.
+     */
+    Game(int psize = 3, int pwinLength = 3, GameRecordArena* precords = nullptr, GameLogWriter* plog = nullptr) : size(psize), winLength(pwinLength), 
+        records(precords), log(plog), output(Full) {};
+    /**
+     * @brief Function to record a finished game in the arena and the game log, if there are.
+     * @param game const GameBoard&. The board of the game.
+     * @return void
+     */
+    void record(const GameBoard& game){
+        if (records){
+            records->add(game);
+        }
+        if (log){
+            log->add(game);
+        }
+    };
+    /**
+     * @brief Starting a game. Player 1 plays X and starts, Player 2 plays O.
+     * @param player1 Player*. The first player, a human or a computer.
+     * @param player2 Player*. The second player.
+     * @return void
+     * The players choose their fields and the loop inserts them, so the same loop is used for Human vs Human, Human vs Computer and Computer vs 
+     * Computer. While a player chooses, the other one may ponder on the board. Lines end with '\n' instead of std::endl, the output is flushed when a 
+     * human is asked for a field (std::cin is tied to std::cout).
+     * Games with a human should use the Full output.
+     */
+    void start(Player* player1, Player* player2){
+        GameBoard game = GameBoard(size, winLength);
+        bool everyMove = output == Full;
+        if (everyMove){
+            game.printBoard();
+            std::cout << "Player 1: X\n";
+            std::cout << "Player 2: O\n";
+        }
+        Player* players[2] = {player1, player2};
+        static constexpr char symbols[2] = {'X', 'O'};
+        for (int turn = 0; ; turn ^= 1){
+            if (everyMove){
+                std::cout << "Player " << turn + 1 << "'s turn\n";
+            }
+            players[turn ^ 1]->ponder(game, symbols[turn ^ 1]);
+            int cell = players[turn]->chooseMove(game, symbols[turn]);
+            players[turn ^ 1]->stopPondering();
+            if (cell < 0){
+                break;
+            }
+            game.insert(cell / size, cell % size, symbols[turn]);
+            if (everyMove){
+                game.printBoard();
+            }
+            if (game.isWinner(symbols[turn]) || game.isDraw()){
+                if (output == FinalBoard){
+                    game.printBoard();
+                }
+                if (game.isWinner(symbols[turn])){
+                    std::cout << "Winner is: Player " << turn + 1 << "\n";
+                } else {
+                    std::cout << "A draw!\n";
+                }
+                break;
+            }
+        }
+        std::cout.flush();
+        record(game);
+    };
+};
+/**
+ * @brief Function to print the games of a game log.
+ * @param path const char*. The path of the log.
+ * @param output Game::Output. Full prints the board after every move, FinalBoard the board at the end of every game and Quiet one line per game.
+ * @return bool. False if the log can not be read or is corrupt, the games before the corrupt one are printed.
+ * The boards are formatted into a buffer that is written when it is full, so printing millions of games is not slowed down by the output.
+ */
+bool replayLog(const char* path, Game::Output output);
+/**
+ * @brief Function to print the statistics of a game log.
+ * @param path const char*. The path of the log.
+ * @return bool. False if the log can not be read.
+ */
+bool printLogStatistics(const char* path);
+/**
+ * @brief Function to let the user choose a larger board and an opponent.
+ * @param threads int. The number of threads the computer searches with.
+ * @param stats bool. True to print the statistics of every search.
+ * @param ponder bool. True to let the computer search while the human thinks.
+ * @param deadline double. The hard limit for every move of the computer in seconds, 0 for none.
+ * @return bool. False if the input was invalid.
+ */
+bool chooseLargerBoard(int threads, bool stats, bool ponder, double deadline);
+#endif